@@ -0,0 +1,95 @@
+// benchmarks/async_single_flight.cpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/async_single_flight.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// 64 requesters fetch keys following a Zipfian distribution. The loader
+// simulates a backend with a fixed latency. Without coalescing every
+// request would hit the backend: the number of loads shows how many
+// requests were served by attaching to an in-flight load.
+
+namespace {
+constexpr std::size_t requesters{64u};
+constexpr std::size_t requests{2000u};
+constexpr std::size_t keys{10000u};
+constexpr double      skew{1.0};
+constexpr auto        backend_latency{std::chrono::microseconds(50)};
+
+class zipf {
+    std::vector<double> cdf;
+
+  public:
+    zipf(std::size_t n, double s) : cdf(n) {
+        double sum{};
+        for (std::size_t i{}; i != n; ++i) {
+            sum += 1.0 / std::pow(double(i + 1u), s);
+            cdf[i] = sum;
+        }
+        for (auto& c : cdf) {
+            c /= sum;
+        }
+    }
+    template <typename Generator>
+    auto operator()(Generator& gen) const -> int {
+        double u{std::uniform_real_distribution<double>(0.0, 1.0)(gen)};
+        return int(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+    }
+};
+
+auto run(const char* name, std::chrono::steady_clock::duration ttl) -> void {
+    std::atomic<std::size_t>          loads{};
+    bt::async_single_flight<int, int> flight(
+        bt::inline_scheduler(),
+        [&loads](const int& key) -> ex::task<int> {
+            loads.fetch_add(1u, std::memory_order_relaxed);
+            std::this_thread::sleep_for(backend_latency);
+            co_return key;
+        },
+        ttl);
+    const zipf dist(keys, skew);
+
+    auto start{std::chrono::steady_clock::now()};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t{}; t != requesters; ++t) {
+            threads.emplace_back([&flight, &dist, t] {
+                std::mt19937_64 gen(t);
+                for (std::size_t r{}; r != requests; ++r) {
+                    int key{dist(gen)};
+                    auto [value]{*ex::sync_wait(flight.get(key))};
+                    if (value != key) {
+                        std::terminate();
+                    }
+                }
+            });
+        }
+    }
+    std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    std::size_t total{requesters * requests};
+    std::cout << name << ": requests=" << total << " loads=" << loads.load() << " ("
+              << (100.0 * double(loads.load()) / double(total)) << "%) time=" << elapsed.count()
+              << "s throughput=" << (double(total) / elapsed.count()) << " req/s\n";
+}
+} // namespace
+
+int main() {
+    run("single-flight", std::chrono::steady_clock::duration::zero());
+    run("single-flight+ttl", std::chrono::seconds(10));
+}
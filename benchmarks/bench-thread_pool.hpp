@@ -0,0 +1,119 @@
+// benchmarks/bench-thread_pool.hpp                                   -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_BENCHMARKS_BENCH_THREAD_POOL
+#define INCLUDED_BENCHMARKS_BENCH_THREAD_POOL
+
+// ----------------------------------------------------------------------------
+
+#include <beman/execution/execution.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bench {
+// A simple FIFO thread pool with a configurable number of workers.
+struct thread_pool {
+    struct node {
+        node*        next{};
+        virtual void run() = 0;
+
+      protected:
+        ~node() = default;
+    };
+
+    std::mutex                mutex;
+    std::condition_variable   condition;
+    node*                     head{};
+    node*                     tail{};
+    bool                      stopped{false};
+    std::vector<std::jthread> workers;
+
+    explicit thread_pool(std::size_t n) {
+        for (std::size_t i{}; i != n; ++i) {
+            this->workers.emplace_back([this] {
+                while (node* n = this->pop()) {
+                    n->run();
+                }
+            });
+        }
+    }
+    ~thread_pool() {
+        {
+            std::lock_guard cerberus(this->mutex);
+            this->stopped = true;
+        }
+        this->condition.notify_all();
+        this->workers.clear();
+    }
+
+    node* pop() {
+        std::unique_lock cerberus(this->mutex);
+        this->condition.wait(cerberus, [this] { return this->stopped || this->head; });
+        node* n{this->head};
+        if (n) {
+            this->head = n->next;
+            if (this->head == nullptr) {
+                this->tail = nullptr;
+            }
+        }
+        return n;
+    }
+    void push(node* n) {
+        {
+            std::lock_guard cerberus(this->mutex);
+            n->next = nullptr;
+            (this->tail ? this->tail->next : this->head) = n;
+            this->tail                                   = n;
+        }
+        this->condition.notify_one();
+    }
+
+    struct scheduler {
+        using scheduler_concept = beman::execution::scheduler_t;
+        struct env {
+            thread_pool* pool;
+
+            template <typename T>
+            scheduler query(const beman::execution::get_completion_scheduler_t<T>&) const noexcept {
+                return {this->pool};
+            }
+        };
+        template <typename Receiver>
+        struct state final : thread_pool::node {
+            using operation_state_concept = beman::execution::operation_state_t;
+            std::remove_cvref_t<Receiver> receiver;
+            thread_pool*                  pool;
+
+            template <typename R>
+            state(R&& r, thread_pool* p) : node{}, receiver(std::forward<R>(r)), pool(p) {}
+            void start() & noexcept { this->pool->push(this); }
+            void run() override { beman::execution::set_value(std::move(this->receiver)); }
+        };
+        struct sender {
+            using sender_concept        = beman::execution::sender_t;
+            using completion_signatures = beman::execution::completion_signatures<beman::execution::set_value_t()>;
+            thread_pool* pool;
+            template <typename Receiver>
+            state<Receiver> connect(Receiver&& receiver) {
+                return state<Receiver>(std::forward<Receiver>(receiver), pool);
+            }
+
+            env get_env() const noexcept { return {this->pool}; }
+        };
+        thread_pool* pool;
+        sender       schedule() { return {this->pool}; }
+        bool         operator==(const scheduler&) const = default;
+    };
+    scheduler get_scheduler() { return {this}; }
+};
+
+static_assert(beman::execution::scheduler<thread_pool::scheduler>);
+} // namespace bench
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,110 @@
+// benchmarks/detached_task.cpp                                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detached_task.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/task_scope.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// 100k fire-and-forget coroutines are started on a run_loop which is run
+// once all of them are outstanding. They are spawned as a task into the
+// scope from examples/demo-scope.hpp, i.e., using a task operation state
+// and a heap allocated job, and as detached_tasks accounted for by a
+// task_scope.
+
+namespace {
+// The job management of demo::scope from examples/demo-scope.hpp.
+class new_scope {
+    struct job_base {
+        virtual ~job_base() = default;
+    };
+    struct receiver {
+        using receiver_concept = ex::receiver_t;
+        new_scope* self;
+        job_base*  state{};
+
+        auto set_value() && noexcept -> void { this->complete(); }
+        auto set_error(auto&&) && noexcept -> void { std::terminate(); }
+        auto set_stopped() && noexcept -> void { this->complete(); }
+        auto complete() noexcept -> void {
+            new_scope* slf{this->self};
+            delete this->state;
+            --slf->count;
+        }
+    };
+    template <typename Sender>
+    struct job : job_base {
+        using state_t = decltype(ex::connect(std::declval<Sender&&>(), std::declval<receiver>()));
+        state_t state;
+        template <typename S>
+        job(new_scope* self, S&& sender) : state(ex::connect(std::forward<S>(sender), receiver{self, this})) {
+            ex::start(this->state);
+        }
+    };
+
+    std::atomic<std::size_t> count{};
+
+  public:
+    template <ex::sender Sender>
+    auto spawn(Sender&& sender) {
+        ++this->count;
+        new job<std::remove_cvref_t<Sender>>(this, std::forward<Sender>(sender));
+    }
+    auto empty() const -> bool { return 0u == this->count; }
+};
+
+constexpr std::size_t spawns{100000u};
+
+auto work(std::size_t& sum, std::size_t i) -> ex::task<> {
+    sum += i;
+    co_return;
+}
+auto detached_work(auto, bt::task_scope<>&, std::size_t& sum, std::size_t i) -> bt::detached_task<> {
+    sum += i;
+    co_return;
+}
+
+auto measure(const char* name, auto spawn) -> double {
+    ex::run_loop loop;
+    std::size_t  sum{};
+    auto         start{std::chrono::steady_clock::now()};
+    for (std::size_t i{}; i != spawns; ++i) {
+        spawn(loop.get_scheduler(), sum, i);
+    }
+    loop.finish();
+    loop.run();
+    std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+    if (sum != spawns * (spawns - 1u) / 2u) {
+        std::cout << "unexpected result\n";
+    }
+    std::cout << name << ": " << elapsed.count() << "ms (" << (spawns / elapsed.count()) << " spawns/ms)\n";
+    return elapsed.count();
+}
+} // namespace
+
+int main() {
+    new_scope        demo;
+    bt::task_scope<> scope;
+    auto             spawn_task{[&demo](auto sched, std::size_t& sum, std::size_t i) {
+        demo.spawn(ex::starts_on(
+            sched, ex::detail::write_env(work(sum, i), ex::detail::make_env(ex::get_scheduler, sched))));
+    }};
+    auto             spawn_detached{[&scope](auto sched, std::size_t& sum, std::size_t i) {
+        detached_work(sched, scope, sum, i);
+    }};
+    double           task{measure("demo scope spawn(task)", spawn_task)};
+    double           detached{measure("detached_task", spawn_detached)};
+    ex::sync_wait(scope.join());
+    std::cout << "speedup=" << (task / detached) << "\n";
+}
@@ -0,0 +1,100 @@
+// benchmarks/edf_scheduler.cpp                                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/edf_scheduler.hpp>
+#include <beman/task/priority_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// Requests with deadlines are submitted in bursts at a rate exceeding the
+// capacity of the workers. The fraction of requests completing after their
+// deadline is measured for an edf_context and, for comparison, for a
+// priority_context with a single lane, i.e., a FIFO scheduler. Requests
+// dropped by the edf_context because their deadline already passed count
+// as misses.
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t workers{4u};
+constexpr std::size_t requests{20000u};
+constexpr std::size_t burst{64u};
+constexpr auto        cost{std::chrono::microseconds(20)};
+constexpr auto        gap{std::chrono::microseconds(250)};
+
+auto spin(clock_type::duration d) -> void {
+    auto end{clock_type::now() + d};
+    while (clock_type::now() < end) {
+    }
+}
+
+struct counters {
+    std::atomic<std::size_t> met{};
+    std::atomic<std::size_t> missed{};
+    std::latch               done{std::ptrdiff_t(requests)};
+};
+
+struct request_receiver {
+    using receiver_concept = ex::receiver_t;
+    counters*                c;
+    bt::deadline_environment env;
+
+    void set_value() && noexcept {
+        spin(cost);
+        ++(clock_type::now() <= this->env.deadline ? this->c->met : this->c->missed);
+        this->c->done.count_down();
+    }
+    void set_stopped() && noexcept {
+        ++this->c->missed;
+        this->c->done.count_down();
+    }
+    auto get_env() const noexcept -> const bt::deadline_environment& { return this->env; }
+};
+
+template <typename Scheduler>
+auto measure(Scheduler scheduler) -> double {
+    using op_t = decltype(ex::connect(ex::schedule(scheduler), std::declval<request_receiver>()));
+    counters                                    c;
+    std::vector<std::unique_ptr<op_t>>          ops;
+    std::mt19937                                rng(17u);
+    std::uniform_int_distribution<std::int64_t> slack(100, 5000);
+    ops.reserve(requests);
+
+    for (std::size_t i{}; i != requests; ++i) {
+        if (i % burst == 0u) {
+            spin(gap);
+        }
+        auto deadline{clock_type::now() + std::chrono::microseconds(slack(rng))};
+        ops.emplace_back(new op_t(ex::connect(ex::schedule(scheduler),
+                                              request_receiver{&c, bt::deadline_environment(deadline)})));
+        ex::start(*ops.back());
+    }
+    c.done.wait();
+    return 100.0 * double(c.missed) / double(requests);
+}
+} // namespace
+
+int main() {
+    {
+        bt::edf_context context(workers);
+        std::cout << "edf:  missed=" << measure(context.get_scheduler()) << "%\n";
+    }
+    {
+        bt::priority_context context(workers, 1u);
+        std::cout << "fifo: missed=" << measure(context.get_scheduler()) << "%\n";
+    }
+}
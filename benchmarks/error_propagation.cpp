@@ -0,0 +1,66 @@
+// benchmarks/error_propagation.cpp                                   -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <system_error>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// An error produced at the bottom of a chain of 10 nested tasks is
+// propagated to the top. By default each level rethrows the error when
+// resuming from co_await. With forward_errors the error is passed up as
+// the result of each level without any exception.
+
+namespace {
+constexpr int depth{10};
+constexpr int repetitions{10000};
+
+struct throwing_context {
+    using scheduler_type = bt::inline_scheduler;
+    using error_types =
+        ex::completion_signatures<ex::set_error_t(std::error_code), ex::set_error_t(std::exception_ptr)>;
+};
+struct forwarding_context {
+    using scheduler_type = bt::inline_scheduler;
+    using error_types    = ex::completion_signatures<ex::set_error_t(std::error_code)>;
+    static constexpr bool forward_errors{true};
+};
+
+template <typename Context>
+auto chain(int level) -> ex::task<int, Context> {
+    if (level == 0) {
+        co_yield bt::with_error(std::make_error_code(std::errc::io_error));
+    }
+    co_return 1 + co_await chain<Context>(level - 1);
+}
+
+template <typename Context>
+auto measure(const char* name) -> double {
+    int  errors{};
+    auto start{std::chrono::steady_clock::now()};
+    for (int i{}; i != repetitions; ++i) {
+        ex::sync_wait(chain<Context>(depth) | ex::upon_error([&errors](auto) {
+                          ++errors;
+                          return 0;
+                      }));
+    }
+    std::chrono::duration<double, std::micro> elapsed{std::chrono::steady_clock::now() - start};
+    if (errors != repetitions) {
+        std::cout << "unexpected result\n";
+    }
+    std::cout << name << ": " << (elapsed.count() / repetitions) << "us per error at depth " << depth << "\n";
+    return elapsed.count();
+}
+} // namespace
+
+int main() {
+    double thrown{measure<throwing_context>("rethrow per level")};
+    double forwarded{measure<forwarding_context>("forward_errors")};
+    std::cout << "speedup=" << (thrown / forwarded) << "\n";
+}
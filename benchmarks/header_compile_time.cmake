@@ -0,0 +1,115 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+# Measure the cost of including the library's headers. For each header a
+# translation unit including only this header is
+# - preprocessed to determine the size of the code the compiler needs to
+#   parse and whether <iostream> (and its static initialiser) is pulled in,
+# - compiled with -fsyntax-only REPETITIONS times to determine the average
+#   time spent in the front end,
+# - if NM is set, compiled to an object whose symbols show whether the
+#   header adds a static initialiser to each translation unit including it.
+# <beman/execution/execution.hpp> is measured as the baseline the task
+# headers build on.
+#
+# The script is run by the beman.task.benchmarks.header_compile_time target
+# which passes these variables:
+#   COMPILER     the C++ compiler (GCC or Clang command line syntax)
+#   FLAGS        |-separated compiler flags, e.g., the language standard
+#   INCLUDES     |-separated include directories
+#   DEFINES      |-separated preprocessor definitions
+#   HEADERS      |-separated headers to measure
+#   REPETITIONS  number of compilations per header
+#   NM           optional nm tool listing the symbols of an object file
+#   WORK_DIR     directory for the generated translation units
+
+cmake_minimum_required(VERSION 3.25)
+
+foreach(variable COMPILER HEADERS WORK_DIR)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "header_compile_time: ${variable} isn't set")
+    endif()
+endforeach()
+if(NOT DEFINED REPETITIONS)
+    set(REPETITIONS 5)
+endif()
+
+string(REPLACE "|" ";" FLAGS "${FLAGS}")
+string(REPLACE "|" ";" INCLUDES "${INCLUDES}")
+string(REPLACE "|" ";" DEFINES "${DEFINES}")
+string(REPLACE "|" ";" HEADERS "${HEADERS}")
+set(arguments ${FLAGS})
+foreach(include IN LISTS INCLUDES)
+    list(APPEND arguments "-I${include}")
+endforeach()
+foreach(define IN LISTS DEFINES)
+    list(APPEND arguments "-D${define}")
+endforeach()
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+function(now_us result)
+    # seconds since the epoch followed by 6 digits of microseconds
+    string(TIMESTAMP value "%s%f" UTC)
+    set(${result} ${value} PARENT_SCOPE)
+endfunction()
+
+foreach(header IN LISTS HEADERS)
+    string(MAKE_C_IDENTIFIER "${header}" name)
+    set(source "${WORK_DIR}/${name}.cpp")
+    set(preprocessed "${WORK_DIR}/${name}.ii")
+    file(WRITE "${source}" "#include <${header}>\n")
+
+    execute_process(
+        COMMAND ${COMPILER} ${arguments} -E "${source}" -o "${preprocessed}"
+        RESULT_VARIABLE rc
+        ERROR_VARIABLE error
+    )
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "header_compile_time: can't preprocess <${header}>:\n${error}")
+    endif()
+    file(SIZE "${preprocessed}" bytes)
+    math(EXPR kib "${bytes} / 1024")
+    # line markers name each included file
+    file(STRINGS "${preprocessed}" iostream REGEX "^# [0-9]+ \"[^\"]*[/\\\\]iostream\"" LIMIT_COUNT 1)
+    if(iostream)
+        set(iostream "yes")
+    else()
+        set(iostream "no")
+    endif()
+
+    now_us(start)
+    foreach(i RANGE 1 ${REPETITIONS})
+        execute_process(
+            COMMAND ${COMPILER} ${arguments} -fsyntax-only "${source}"
+            RESULT_VARIABLE rc
+            ERROR_VARIABLE error
+        )
+        if(NOT rc EQUAL 0)
+            message(FATAL_ERROR "header_compile_time: can't compile <${header}>:\n${error}")
+        endif()
+    endforeach()
+    now_us(stop)
+    math(EXPR ms "(${stop} - ${start}) / (1000 * ${REPETITIONS})")
+
+    set(static_init "")
+    if(NM)
+        set(object "${WORK_DIR}/${name}.o")
+        execute_process(
+            COMMAND ${COMPILER} ${arguments} -c "${source}" -o "${object}"
+            RESULT_VARIABLE rc
+            ERROR_VARIABLE error
+        )
+        if(NOT rc EQUAL 0)
+            message(FATAL_ERROR "header_compile_time: can't compile <${header}>:\n${error}")
+        endif()
+        execute_process(COMMAND ${NM} "${object}" OUTPUT_VARIABLE symbols RESULT_VARIABLE rc)
+        # GCC and Clang name the function running a TU's initialisers _GLOBAL__sub_I_*
+        if(symbols MATCHES "_GLOBAL__sub_I_")
+            set(static_init ", static init: yes")
+        else()
+            set(static_init ", static init: no")
+        endif()
+    endif()
+
+    message("<${header}>: ${kib} KiB preprocessed, iostream: ${iostream}, ${ms} ms syntax-only${static_init}")
+endforeach()
@@ -0,0 +1,143 @@
+// benchmarks/io_uring_context.cpp                                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/io_uring_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Random 4KiB reads from a 64MiB file on tmpfs (/dev/shm): blocking pread
+// from one thread versus async_read on an io_uring_context with a number
+// of tasks reading concurrently, once with plain and once with registered
+// buffers and files.
+
+#ifdef BEMAN_TASK_HAS_IO_URING
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t file_size{64u << 20};
+constexpr std::size_t block{4096u};
+constexpr std::size_t reads{200000u};
+constexpr std::size_t tasks{64u};
+
+auto offsets() -> std::vector<std::uint64_t> {
+    std::mt19937                               rng(17u);
+    std::uniform_int_distribution<std::size_t> dist(0u, file_size / block - 1u);
+    std::vector<std::uint64_t>                  result(reads);
+    for (auto& offset : result) {
+        offset = dist(rng) * block;
+    }
+    return result;
+}
+
+auto report(const char* name, clock_type::time_point start) -> void {
+    std::chrono::duration<double> elapsed{clock_type::now() - start};
+    std::cout << name << ": " << double(reads) / elapsed.count() / 1e3 << "k reads/s, "
+              << double(reads * block) / elapsed.count() / double(1u << 30) << "GiB/s\n";
+}
+
+auto blocking(int fd, const std::vector<std::uint64_t>& offs) -> void {
+    std::vector<std::byte> buffer(block);
+    auto                   start{clock_type::now()};
+    for (auto offset : offs) {
+        if (::pread(fd, buffer.data(), block, ::off_t(offset)) != ::ssize_t(block)) {
+            std::cout << "pread failed\n";
+        }
+    }
+    report("blocking pread", start);
+}
+
+template <typename File, typename Buffer>
+auto reader(bt::io_uring_scheduler             sched,
+            File                               file,
+            Buffer                             buffer,
+            const std::vector<std::uint64_t>& offs,
+            std::size_t                        first) -> ex::task<> {
+    for (std::size_t i{first}; i < offs.size(); i += tasks) {
+        if (co_await bt::async_read(sched, file, buffer, offs[i]) != block) {
+            std::cout << "async_read failed\n";
+        }
+    }
+}
+
+struct reader_env {
+    bt::io_uring_scheduler sched;
+    auto                   query(const ex::get_scheduler_t&) const noexcept { return this->sched; }
+};
+struct done_receiver {
+    using receiver_concept = ex::receiver_t;
+    std::latch*            latch;
+    bt::io_uring_scheduler sched;
+
+    void set_value() && noexcept { this->latch->count_down(); }
+    void set_error(std::exception_ptr) && noexcept { this->latch->count_down(); }
+    void set_stopped() && noexcept { this->latch->count_down(); }
+    auto get_env() const noexcept { return reader_env{this->sched}; }
+};
+struct job {
+    decltype(ex::connect(std::declval<ex::task<>>(), std::declval<done_receiver>())) op;
+    job(ex::task<> t, done_receiver r) : op(ex::connect(std::move(t), r)) {}
+};
+
+auto uring(int fd, const std::vector<std::uint64_t>& offs, bool registered) -> void {
+    bt::io_uring_context   context;
+    auto                   sched{context.get_scheduler()};
+    std::vector<std::byte> storage(tasks * block);
+    ::iovec                iov{storage.data(), storage.size()};
+    if (registered) {
+        context.register_buffers(std::span(&iov, 1u));
+        context.register_files(std::span(&fd, 1u));
+    }
+
+    std::latch                        done{std::ptrdiff_t(tasks)};
+    std::vector<std::unique_ptr<job>> jobs;
+    auto                              start{clock_type::now()};
+    // All readers run concurrently: their requests are submitted in batches.
+    for (std::size_t t{}; t != tasks; ++t) {
+        std::span<std::byte>  buffer(storage.data() + t * block, block);
+        bt::registered_buffer fixed{0u, buffer};
+        auto                  task{registered ? reader(sched, bt::registered_file{0u}, fixed, offs, t)
+                                              : reader(sched, fd, buffer, offs, t)};
+        jobs.emplace_back(new job(std::move(task), done_receiver{&done, sched}));
+        ex::start(jobs.back()->op);
+    }
+    done.wait();
+    report(registered ? "io_uring (registered)" : "io_uring", start);
+}
+} // namespace
+
+int main() {
+    const char* path{"/dev/shm/beman-task-io_uring-benchmark"};
+    int         fd{::open(path, O_RDWR | O_CREAT | O_TRUNC, 0600)};
+    if (fd < 0 || ::ftruncate(fd, ::off_t(file_size)) != 0) {
+        std::cout << "can't create " << path << "\n";
+        return 1;
+    }
+    auto offs{offsets()};
+    blocking(fd, offs);
+    uring(fd, offs, false);
+    uring(fd, offs, true);
+    ::close(fd);
+    ::unlink(path);
+}
+#else
+int main() { std::cout << "io_uring isn't available on this platform\n"; }
+#endif
@@ -0,0 +1,75 @@
+// benchmarks/parallel_for.cpp                                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "bench-thread_pool.hpp"
+#include <beman/task/parallel_for.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// Score 100k candidates using parallel_for and parallel_transform_reduce on
+// thread pools with 1 to N workers and report the speedup relative to one
+// worker.
+
+namespace {
+constexpr std::size_t candidates{100000u};
+constexpr std::size_t chunk{1024u};
+constexpr int         repetitions{10};
+
+auto score(double c) -> double {
+    double s{c};
+    for (int i{}; i != 64; ++i) {
+        s = std::sqrt(s * s + c + double(i));
+    }
+    return s;
+}
+
+auto measure(std::size_t workers, std::vector<double>& values, std::vector<double>& scores) -> double {
+    bench::thread_pool pool(workers);
+    auto               start{std::chrono::steady_clock::now()};
+    double             total{};
+    for (int r{}; r != repetitions; ++r) {
+        ex::sync_wait([](auto sched, auto& in, auto& out, double& sum) -> ex::task<> {
+            co_await bt::parallel_for(sched, std::views::iota(std::size_t(), in.size()), chunk, [&](std::size_t i) {
+                out[i] = score(in[i]);
+            });
+            sum = co_await bt::parallel_transform_reduce(sched, in, chunk, 0.0, std::plus<>(), score);
+        }(pool.get_scheduler(), values, scores, total));
+    }
+    std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    if (total == 0.0) {
+        std::cout << "unexpected result\n";
+    }
+    return elapsed.count();
+}
+} // namespace
+
+int main() {
+    std::vector<double> values(candidates);
+    for (std::size_t i{}; i != values.size(); ++i) {
+        values[i] = double(i % 1000u);
+    }
+    std::vector<double> scores(candidates);
+
+    std::size_t cores{std::max(1u, std::thread::hardware_concurrency())};
+    double      base{};
+    for (std::size_t workers{1u}; workers <= cores; ++workers) {
+        double time{measure(workers, values, scores)};
+        if (workers == 1u) {
+            base = time;
+        }
+        std::cout << "workers=" << workers << " time=" << time << "s speedup=" << (base / time) << "\n";
+    }
+}
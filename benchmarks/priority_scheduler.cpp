@@ -0,0 +1,83 @@
+// benchmarks/priority_scheduler.cpp                                  -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/priority_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// Background tasks keep all workers of a priority_context saturated with
+// work on the least urgent lane. The latency between scheduling a
+// continuation and it getting run is measured for continuations on the
+// most urgent lane and, for comparison, on the background lane which
+// corresponds to a FIFO scheduler.
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t workers{4u};
+constexpr std::size_t background_tasks{32u};
+constexpr std::size_t samples{2000u};
+constexpr auto        slice{std::chrono::microseconds(100)};
+
+auto spin(clock_type::duration d) -> void {
+    auto end{clock_type::now() + d};
+    while (clock_type::now() < end) {
+    }
+}
+
+auto background(const std::atomic<bool>& stop) -> ex::task<> {
+    while (not stop) {
+        spin(slice);
+        co_await bt::yield();
+    }
+}
+
+auto percentile(std::vector<double>& values, double p) -> double {
+    std::sort(values.begin(), values.end());
+    return values[std::size_t(p * double(values.size() - 1u))];
+}
+
+auto measure(bt::priority_context& context, std::size_t lane) -> std::vector<double> {
+    std::vector<double> latencies;
+    for (std::size_t i{}; i != samples; ++i) {
+        auto submitted{clock_type::now()};
+        auto [ran]{
+            *ex::sync_wait(ex::schedule(context.get_scheduler(lane)) | ex::then([] { return clock_type::now(); }))};
+        latencies.push_back(std::chrono::duration<double, std::micro>(ran - submitted).count());
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return latencies;
+}
+} // namespace
+
+int main() {
+    bt::priority_context context(workers, 3u, std::chrono::milliseconds(50));
+    std::atomic<bool>    stop{false};
+
+    std::vector<std::jthread> drivers;
+    for (std::size_t i{}; i != background_tasks; ++i) {
+        drivers.emplace_back(
+            [&context, &stop] { ex::sync_wait(ex::starts_on(context.get_scheduler(2), background(stop))); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (auto [name, lane] :
+         {std::pair{"high priority", std::size_t(0u)}, std::pair{"fifo (background lane)", std::size_t(2u)}}) {
+        auto latencies{measure(context, lane)};
+        std::cout << name << ": p50=" << percentile(latencies, 0.5) << "us p99=" << percentile(latencies, 0.99)
+                  << "us\n";
+    }
+    stop = true;
+}
@@ -0,0 +1,80 @@
+// benchmarks/resume_by_reference.cpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// A task returns a 4 KiB struct which the awaiting coroutine consumes as
+// part of the co_await expression. By default the result is moved out of
+// the awaited task's result into the value of the co_await expression.
+// With resume_by_reference the co_await expression refers to the result
+// directly and the copy of the 4 KiB is avoided.
+
+namespace {
+constexpr int repetitions{100000};
+
+struct value_context {
+    using scheduler_type = bt::inline_scheduler;
+};
+struct reference_context {
+    using scheduler_type = bt::inline_scheduler;
+    static constexpr bool resume_by_reference{true};
+};
+
+struct page {
+    static inline std::size_t moves{};
+    std::array<std::byte, 4096u> data{};
+
+    page() = default;
+    page(page&& other) noexcept : data(other.data) { ++moves; }
+};
+
+template <typename Context>
+auto produce(int i) -> ex::task<page, Context> {
+    page p;
+    p.data[i % p.data.size()] = std::byte{1};
+    co_return std::move(p);
+}
+
+auto consume(const page& p) -> std::size_t {
+    std::size_t sum{};
+    for (std::byte b : p.data) {
+        sum += std::to_integer<std::size_t>(b);
+    }
+    return sum;
+}
+
+template <typename Context>
+auto measure(const char* name) -> double {
+    std::size_t sum{};
+    page::moves = 0u;
+    auto start{std::chrono::steady_clock::now()};
+    ex::sync_wait([](std::size_t& s) -> ex::task<void, value_context> {
+        for (int i{}; i != repetitions; ++i) {
+            s += consume(co_await produce<Context>(i));
+        }
+    }(sum));
+    std::chrono::duration<double, std::micro> elapsed{std::chrono::steady_clock::now() - start};
+    if (sum != repetitions) {
+        std::cout << "unexpected result\n";
+    }
+    std::cout << name << ": " << (elapsed.count() * 1000.0 / repetitions)
+              << "ns per co_await, moves per co_await=" << (double(page::moves) / repetitions) << "\n";
+    return elapsed.count();
+}
+} // namespace
+
+int main() {
+    double by_value{measure<value_context>("by value")};
+    double by_reference{measure<reference_context>("resume_by_reference")};
+    std::cout << "speedup=" << (by_value / by_reference) << "\n";
+}
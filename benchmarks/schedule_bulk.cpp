@@ -0,0 +1,63 @@
+// benchmarks/schedule_bulk.cpp                                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "bench-thread_pool.hpp"
+#include <beman/task/parallel_for.hpp>
+#include <beman/task/priority_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <ranges>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// A task fans out 10k trivial children through its task_scheduler: once
+// with one schedule() per child (using parallel_for with chunks of one
+// element) and once with schedule_bulk. The priority_context supports
+// bulk submission natively; the simple thread pool gets the fallback
+// submitting everything as one work item.
+
+namespace {
+constexpr std::size_t children{10000u};
+constexpr int         repetitions{100};
+
+template <typename Scheduler>
+auto measure(const char* name, Scheduler sched) -> void {
+    std::atomic<std::size_t> sum{};
+    auto                     child{[&sum](std::size_t i) { sum.fetch_add(i, std::memory_order_relaxed); }};
+    auto                     run{[&](bool bulk) {
+        auto start{std::chrono::steady_clock::now()};
+        for (int r{}; r != repetitions; ++r) {
+            ex::sync_wait(ex::starts_on(sched, [](bool b, auto& fn) -> ex::task<> {
+                auto s{co_await ex::read_env(ex::get_scheduler)};
+                if (b) {
+                    co_await s.schedule_bulk(children, fn);
+                } else {
+                    co_await bt::parallel_for(s, std::views::iota(std::size_t(), children), 1u, fn);
+                }
+            }(bulk, child)));
+        }
+        std::chrono::duration<double, std::micro> elapsed{std::chrono::steady_clock::now() - start};
+        return elapsed.count() / repetitions;
+    }};
+    double single{run(false)};
+    double bulk{run(true)};
+    if (sum != 2u * repetitions * (children * (children - 1u) / 2u)) {
+        std::cout << "unexpected result\n";
+    }
+    std::cout << name << ": schedule per child=" << single << "us schedule_bulk=" << bulk
+              << "us speedup=" << (single / bulk) << "\n";
+}
+} // namespace
+
+int main() {
+    bt::priority_context context(4u);
+    measure("priority_context", context.get_scheduler());
+    bench::thread_pool pool(4u);
+    measure("thread_pool", pool.get_scheduler());
+}
@@ -0,0 +1,115 @@
+// benchmarks/task_scope.cpp                                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/task.hpp>
+#include <beman/task/task_scope.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// 100k tasks are spawned into a scope and run once all of them are
+// outstanding. The scope from examples/demo-scope.hpp allocates each job
+// with new while task_scope takes the jobs from its slab. The global
+// operator new is replaced to count the allocations per spawn.
+
+namespace {
+std::atomic<std::size_t> allocations{};
+
+// The job management of demo::scope from examples/demo-scope.hpp.
+class new_scope {
+    struct job_base {
+        virtual ~job_base() = default;
+    };
+    struct receiver {
+        using receiver_concept = ex::receiver_t;
+        new_scope* self;
+        job_base*  state{};
+
+        auto set_value() && noexcept -> void { this->complete(); }
+        auto set_error(auto&&) && noexcept -> void { std::terminate(); }
+        auto set_stopped() && noexcept -> void { this->complete(); }
+        auto complete() noexcept -> void {
+            new_scope* slf{this->self};
+            delete this->state;
+            --slf->count;
+        }
+    };
+    template <typename Sender>
+    struct job : job_base {
+        using state_t = decltype(ex::connect(std::declval<Sender&&>(), std::declval<receiver>()));
+        state_t state;
+        template <typename S>
+        job(new_scope* self, S&& sender) : state(ex::connect(std::forward<S>(sender), receiver{self, this})) {
+            ex::start(this->state);
+        }
+    };
+
+    std::atomic<std::size_t> count{};
+
+  public:
+    template <ex::sender Sender>
+    auto spawn(Sender&& sender) {
+        ++this->count;
+        new job<std::remove_cvref_t<Sender>>(this, std::forward<Sender>(sender));
+    }
+    auto empty() const -> bool { return 0u == this->count; }
+};
+
+constexpr std::size_t spawns{100000u};
+
+auto work(std::size_t& sum, std::size_t i) -> ex::task<> {
+    sum += i;
+    co_return;
+}
+
+template <typename Scope>
+auto measure(const char* name, Scope& scope) -> void {
+    ex::run_loop loop;
+    std::size_t  sum{};
+    auto         sched{loop.get_scheduler()};
+    std::size_t  before{allocations.load()};
+    auto         start{std::chrono::steady_clock::now()};
+    for (std::size_t i{}; i != spawns; ++i) {
+        scope.spawn(ex::starts_on(
+            sched, ex::detail::write_env(work(sum, i), ex::detail::make_env(ex::get_scheduler, sched))));
+    }
+    loop.finish();
+    loop.run();
+    std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+    std::size_t                               count{allocations.load() - before};
+    if (sum != spawns * (spawns - 1u) / 2u) {
+        std::cout << "unexpected result\n";
+    }
+    std::cout << name << ": allocations per spawn=" << (double(count) / spawns) << " time=" << elapsed.count()
+              << "ms\n";
+}
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+    ++allocations;
+    if (void* ptr{std::malloc(size ? size : 1u)}) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+auto operator delete(void* ptr) noexcept -> void { std::free(ptr); }
+auto operator delete(void* ptr, std::size_t) noexcept -> void { std::free(ptr); }
+
+int main() {
+    new_scope demo;
+    measure("new per job", demo);
+    bt::task_scope<> scope;
+    measure("task_scope", scope);
+    ex::sync_wait(scope.join());
+}
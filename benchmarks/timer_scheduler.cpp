@@ -0,0 +1,75 @@
+// benchmarks/timer_scheduler.cpp                                     -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/task.hpp>
+#include <beman/task/timer_scheduler.hpp>
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// Timers with expiry times spread over the next minute are armed and
+// cancelled again, as happens for timeouts of operations which usually
+// complete in time. The target is at least 1M arm/cancel pairs per second.
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t batch{1000u};
+constexpr std::size_t rounds{2000u};
+
+struct stop_env {
+    ex::inplace_stop_token token;
+    auto                   query(const ex::get_stop_token_t&) const noexcept { return this->token; }
+};
+
+struct counting_receiver {
+    using receiver_concept = ex::receiver_t;
+    std::size_t*           stopped;
+    ex::inplace_stop_token token;
+
+    void set_value() && noexcept {}
+    void set_stopped() && noexcept { ++*this->stopped; }
+    auto get_env() const noexcept { return stop_env{this->token}; }
+};
+
+using op_t = decltype(ex::connect(std::declval<bt::timer_scheduler>().schedule_after(std::chrono::seconds(1)),
+                                  std::declval<counting_receiver>()));
+
+struct timer {
+    ex::inplace_stop_source source;
+    op_t                    op;
+
+    timer(bt::timer_scheduler sched, clock_type::duration delay, std::size_t* stopped)
+        : op(ex::connect(bt::schedule_after(sched, delay), counting_receiver{stopped, this->source.get_token()})) {}
+};
+} // namespace
+
+int main() {
+    bt::timer_context                   context;
+    auto                                sched{context.get_scheduler()};
+    std::size_t                         stopped{};
+    std::vector<std::unique_ptr<timer>> timers(batch);
+
+    auto start{clock_type::now()};
+    for (std::size_t r{}; r != rounds; ++r) {
+        for (std::size_t i{}; i != batch; ++i) {
+            timers[i].reset(new timer(sched, std::chrono::milliseconds(1000 + 59 * i), &stopped));
+            ex::start(timers[i]->op);
+        }
+        for (std::size_t i{}; i != batch; ++i) {
+            timers[i]->source.request_stop();
+        }
+    }
+    std::chrono::duration<double> elapsed{clock_type::now() - start};
+
+    std::cout << "arm/cancel: " << double(stopped) / elapsed.count() / 1e6 << "M/s (" << stopped << " of "
+              << batch * rounds << " cancelled)\n";
+}
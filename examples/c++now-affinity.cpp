@@ -5,6 +5,7 @@
 #include <beman/execution/execution.hpp>
 #include <beman/execution/stop_token.hpp>
 #include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <thread>
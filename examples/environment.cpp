@@ -6,6 +6,7 @@
 #include <beman/execution/execution.hpp>
 #include <beman/net/net.hpp>
 #include <chrono>
+#include <iostream>
 #include <string>
 #include <thread>
 #include <utility>
@@ -4,6 +4,7 @@
 #include <beman/execution/execution.hpp>
 #include <beman/execution/task.hpp>
 #include <beman/net/net.hpp>
+#include <iostream>
 
 namespace ex  = beman::execution;
 namespace net = beman::net;
@@ -0,0 +1,22 @@
+// include/beman/task/async_single_flight.hpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_ASYNC_SINGLE_FLIGHT
+#define INCLUDED_INCLUDE_BEMAN_TASK_ASYNC_SINGLE_FLIGHT
+
+#include <beman/task/detail/async_single_flight.hpp>
+#include <functional>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+template <typename Key,
+          typename Value,
+          typename Context = ::beman::task::detail::default_environment,
+          typename Hash    = ::std::hash<Key>>
+using async_single_flight = ::beman::task::detail::async_single_flight<Key, Value, Context, Hash>;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
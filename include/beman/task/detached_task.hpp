@@ -0,0 +1,19 @@
+// include/beman/task/detached_task.hpp                               -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETACHED_TASK
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETACHED_TASK
+
+#include <beman/task/detail/detached_task.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+template <typename Context = ::beman::task::detail::default_environment>
+using detached_task = ::beman::task::detail::detached_task<Context>;
+using ::beman::task::detail::detached_scope;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
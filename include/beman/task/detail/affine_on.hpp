@@ -6,29 +6,130 @@
 
 #include <beman/execution/execution.hpp>
 #include <beman/task/detail/inline_scheduler.hpp>
+#include <concepts>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 // ----------------------------------------------------------------------------
 
 namespace beman::task::detail {
+/*!
+ * \brief Sender algorithm making sure a sender completes on a scheduler
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * `affine_on(sndr, scheduler)` completes like `sndr` but on `scheduler`.
+ * Usually that is `continues_on(sndr, scheduler)`. The reschedule is
+ * skipped if `scheduler` is the `inline_scheduler` or if `sndr` reports a
+ * completion scheduler comparing equal to `scheduler` for each of its
+ * completions, e.g., when a `task` running on an `epoll_context` awaits
+ * a readiness notification of the same context. The latter is checked
+ * when the operation is connected.
+ *
+ * The optional `skip` is invoked when an operation is connected whose
+ * reschedule isn't elided at compile time. It gets passed whether the
+ * reschedule can be skipped and the reschedule is only skipped if it
+ * returns `true`. A `task` uses that to count the skipped reschedules
+ * against its `resumption_budget`.
+ */
 struct affine_on_t {
-    template <::beman::execution::sender Sender, ::beman::execution::scheduler Scheduler>
+    struct skip_if_possible {
+        auto operator()(bool possible) const noexcept -> bool { return possible; }
+    };
+
+    template <::beman::execution::sender Sender,
+              ::beman::execution::scheduler Scheduler,
+              typename Skip = ::beman::task::detail::affine_on_t::skip_if_possible>
     struct sender;
 
-    template <::beman::execution::sender Sender, ::beman::execution::scheduler Scheduler>
-    auto operator()(Sender&& sndr, Scheduler&& scheduler) const {
-        using result_t = sender<::std::remove_cvref_t<Sender>, ::std::remove_cvref_t<Scheduler>>;
+    template <::beman::execution::sender Sender,
+              ::beman::execution::scheduler Scheduler,
+              typename Skip = ::beman::task::detail::affine_on_t::skip_if_possible>
+    auto operator()(Sender&& sndr, Scheduler&& scheduler, Skip skip = {}) const {
+        using result_t = sender<::std::remove_cvref_t<Sender>, ::std::remove_cvref_t<Scheduler>, Skip>;
         static_assert(::beman::execution::sender<result_t>);
-        return result_t{*this, ::std::forward<Sender>(sndr), ::std::forward<Scheduler>(scheduler)};
+        return result_t{*this, ::std::forward<Sender>(sndr), ::std::forward<Scheduler>(scheduler), ::std::move(skip)};
     }
 };
 
-template <::beman::execution::sender Sender, ::beman::execution::scheduler Scheduler>
+template <::beman::execution::sender Sender, ::beman::execution::scheduler Scheduler, typename Skip>
 struct affine_on_t::sender {
     using sender_concept = ::beman::execution::sender_t;
     template <typename Env>
     static constexpr bool elide_schedule = ::std::same_as<::beman::task::detail::inline_scheduler, Scheduler>;
 
+    template <typename Tag>
+    static constexpr bool reports = requires(const Sender& sndr, const Scheduler& sched) {
+        {
+            ::beman::execution::get_completion_scheduler<Tag>(::beman::execution::get_env(sndr)) == sched
+        } -> ::std::convertible_to<bool>;
+    };
+    template <typename>
+    struct tag_of;
+    template <typename Tag, typename... A>
+    struct tag_of<Tag(A...)> {
+        using type = Tag;
+    };
+    template <typename>
+    struct reports_all : ::std::false_type {};
+    template <typename... Sig>
+    struct reports_all<::beman::execution::completion_signatures<Sig...>>
+        : ::std::bool_constant<(reports<typename tag_of<Sig>::type> && ...)> {};
+    // Whether it can be determined at run time that no reschedule is needed.
+    template <typename Env>
+    static constexpr bool may_elide_schedule =
+        reports_all<::beman::execution::completion_signatures_of_t<Sender, Env>>::value;
+
+    template <typename... Sig>
+    static auto
+    completes_on(const Sender& sndr, const Scheduler& sched, ::beman::execution::completion_signatures<Sig...>*)
+        -> bool {
+        return ((::beman::execution::get_completion_scheduler<typename tag_of<Sig>::type>(
+                     ::beman::execution::get_env(sndr)) == sched) &&
+                ...);
+    }
+
+    template <typename Upstream, typename Receiver>
+    struct state {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        using rescheduled_t =
+            decltype(::beman::execution::continues_on(::std::declval<Upstream>(), ::std::declval<Scheduler>()));
+        struct direct {
+            ::beman::execution::connect_result_t<Upstream, Receiver> op;
+            direct(Upstream&& u, Receiver&& r)
+                : op(::beman::execution::connect(::std::forward<Upstream>(u), ::std::forward<Receiver>(r))) {}
+        };
+        struct rescheduled {
+            ::beman::execution::connect_result_t<rescheduled_t, Receiver> op;
+            rescheduled(Upstream&& u, Scheduler&& sched, Receiver&& r)
+                : op(::beman::execution::connect(
+                      ::beman::execution::continues_on(::std::forward<Upstream>(u), ::std::move(sched)),
+                      ::std::forward<Receiver>(r))) {}
+        };
+
+        ::std::variant<::std::monostate, direct, rescheduled> op;
+
+        state(Upstream&& u, Scheduler sched, const Skip& skip, Receiver&& r) {
+            using signatures_t = ::beman::execution::
+                completion_signatures_of_t<Upstream, decltype(::beman::execution::get_env(r))>;
+            if (skip(sender::completes_on(u, sched, static_cast<signatures_t*>(nullptr)))) {
+                this->op.template emplace<1>(::std::forward<Upstream>(u), ::std::forward<Receiver>(r));
+            } else {
+                this->op.template emplace<2>(
+                    ::std::forward<Upstream>(u), ::std::move(sched), ::std::forward<Receiver>(r));
+            }
+        }
+        state(state&&) = delete;
+        auto start() & noexcept -> void {
+            if (auto* d{::std::get_if<1>(&this->op)}) {
+                ::beman::execution::start(d->op);
+            } else {
+                ::beman::execution::start(::std::get<2>(this->op).op);
+            }
+        }
+    };
+
     template <typename Env>
     auto get_completion_signatures(const Env& env) const& noexcept {
         if constexpr (elide_schedule<Env>) {
@@ -51,13 +152,18 @@ struct affine_on_t::sender {
     affine_on_t tag{};
     Sender      upstream;
     Scheduler   scheduler;
+    Skip        skip;
 
     template <::beman::execution::receiver Receiver>
     auto connect(Receiver&& receiver) const& {
         using env_t = decltype(::beman::execution::get_env(receiver));
         if constexpr (elide_schedule<env_t>) {
             return ::beman::execution::connect(this->upstream, ::std::forward<Receiver>(receiver));
+        } else if constexpr (may_elide_schedule<env_t>) {
+            return state<const Sender&, Receiver>(
+                this->upstream, this->scheduler, this->skip, ::std::forward<Receiver>(receiver));
         } else {
+            this->skip(false);
             return ::beman::execution::connect(::beman::execution::continues_on(this->upstream, this->scheduler),
                                                ::std::forward<Receiver>(receiver));
         }
@@ -67,7 +173,13 @@ struct affine_on_t::sender {
         using env_t = decltype(::beman::execution::get_env(receiver));
         if constexpr (elide_schedule<env_t>) {
             return ::beman::execution::connect(::std::move(this->upstream), ::std::forward<Receiver>(receiver));
+        } else if constexpr (may_elide_schedule<env_t>) {
+            return state<Sender, Receiver>(::std::move(this->upstream),
+                                           ::std::move(this->scheduler),
+                                           this->skip,
+                                           ::std::forward<Receiver>(receiver));
         } else {
+            this->skip(false);
             return ::beman::execution::connect(
                 ::beman::execution::continues_on(::std::move(this->upstream), ::std::move(this->scheduler)),
                 ::std::forward<Receiver>(receiver));
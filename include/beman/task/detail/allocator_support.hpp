@@ -4,7 +4,12 @@
 #ifndef INCLUDED_BEMAN_TASK_DETAIL_ALLOCATOR_SUPPORT
 #define INCLUDED_BEMAN_TASK_DETAIL_ALLOCATOR_SUPPORT
 
+#include <beman/task/detail/exceptions.hpp>
 #include <beman/task/detail/find_allocator.hpp>
+#include <beman/task/detail/frame_cache.hpp>
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+#include <beman/task/detail/frame_registry.hpp>
+#endif
 #include <array>
 #include <concepts>
 #include <cstddef>
@@ -32,8 +37,18 @@ namespace beman::task::detail {
  * the allocator after actually used memory causes the address sanitizer to
  * object! So, the current strategy is to embed space for the allocator
  * into the object and pull it out from there.
+ *
+ * If `RecycleFrames` is `true` and a `frame_cache` is current when an
+ * object is deallocated, the memory is put into the cache if it is empty.
+ * Allocations take the memory from the current cache if it holds memory
+ * of the same size obtained from an equal allocator. With the default
+ * `false` the current cache isn't consulted at all, i.e., objects not
+ * opting into recycling don't pay for the thread-local lookup.
+ *
+ * In builds defining `BEMAN_TASK_FRAME_SIZE_REGISTRY` each allocation and
+ * deallocation is reported to the `frame_registry`.
  */
-template <typename Allocator>
+template <typename Allocator, bool RecycleFrames = false>
 struct allocator_support {
     using allocator_traits = std::allocator_traits<Allocator>;
 
@@ -46,37 +61,85 @@ struct allocator_support {
     }
 
     template <typename... A>
-    static void* operator new(std::size_t size, [[maybe_unused]] A&&... a) {
+    static void* operator new(std::size_t size, A&&... a) {
+        void* ptr{allocator_support::allocate(size, a...)};
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+        ::beman::task::detail::frame_registry::instance().allocated(ptr, size);
+#endif
+        return ptr;
+    }
+    template <typename... A>
+    static void operator delete(void* ptr, std::size_t size, const A&...) {
+        allocator_support::operator delete(ptr, size);
+    }
+    static void operator delete(void* ptr, std::size_t size) {
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+        ::beman::task::detail::frame_registry::instance().deallocated(ptr);
+#endif
+        if constexpr (RecycleFrames) {
+            ::beman::task::detail::frame_cache* cache{::beman::task::detail::frame_cache::current()};
+            if (cache != nullptr && cache->put(ptr, allocator_support::total(size), &allocator_support::release)) {
+                return;
+            }
+        }
+        allocator_support::release(ptr, allocator_support::total(size));
+    }
+
+  private:
+    template <typename... A>
+    static void* allocate(std::size_t size, [[maybe_unused]] const A&... a) {
         if constexpr (::std::same_as<Allocator, ::std::allocator<::std::byte>>) {
+            if (void* ptr{allocator_support::reuse(size, [](void*) { return true; })}) {
+                return ptr;
+            }
             Allocator alloc{};
             return allocator_traits::allocate(alloc, size);
         } else {
             Allocator alloc{::beman::task::detail::find_allocator<Allocator>(a...)};
-            void*     ptr{allocator_traits::allocate(alloc, allocator_support::offset(size) + sizeof(Allocator))};
-            try {
+            if (void* ptr{allocator_support::reuse(allocator_support::total(size), [&alloc, size](void* p) {
+                    return *allocator_support::get_allocator(p, size) == alloc;
+                })}) {
+                return ptr;
+            }
+            void* ptr{allocator_traits::allocate(alloc, allocator_support::total(size))};
+            BEMAN_TASK_TRY {
                 new (allocator_support::get_allocator(ptr, size)) Allocator(alloc);
-            } catch (...) {
-                allocator_traits::deallocate(
-                    alloc, static_cast<std::byte*>(ptr), allocator_support::offset(size) + sizeof(Allocator));
-                throw;
+            }
+            BEMAN_TASK_CATCH_ALL {
+                allocator_traits::deallocate(alloc, static_cast<std::byte*>(ptr), allocator_support::total(size));
+                ::beman::task::detail::rethrow();
             }
             return ptr;
         }
     }
-    template <typename... A>
-    static void operator delete(void* ptr, std::size_t size, const A&...) {
-        allocator_support::operator delete(ptr, size);
+    // The size of the memory used for an object of size `size`.
+    static std::size_t total(std::size_t size) {
+        if constexpr (::std::same_as<Allocator, ::std::allocator<::std::byte>>) {
+            return size;
+        } else {
+            return allocator_support::offset(size) + sizeof(Allocator);
+        }
     }
-    static void operator delete(void* ptr, std::size_t size) {
+    template <typename Equal>
+    static void* reuse([[maybe_unused]] std::size_t size, [[maybe_unused]] Equal equal) {
+        if constexpr (RecycleFrames) {
+            ::beman::task::detail::frame_cache* cache{::beman::task::detail::frame_cache::current()};
+            if (cache != nullptr && cache->holds(size, &allocator_support::release) && equal(cache->peek())) {
+                return cache->take();
+            }
+        }
+        return nullptr;
+    }
+    static void release(void* ptr, std::size_t size) noexcept {
         if constexpr (::std::same_as<Allocator, ::std::allocator<::std::byte>>) {
             Allocator alloc{};
             allocator_traits::deallocate(alloc, static_cast<std::byte*>(ptr), size);
         } else {
-            Allocator* aptr{allocator_support::get_allocator(ptr, size)};
-            Allocator  alloc{*aptr};
+            Allocator* aptr{::std::launder(
+                reinterpret_cast<Allocator*>(static_cast<std::byte*>(ptr) + size - sizeof(Allocator)))};
+            Allocator alloc{*aptr};
             aptr->~Allocator();
-            allocator_traits::deallocate(
-                alloc, static_cast<std::byte*>(ptr), allocator_support::offset(size) + sizeof(Allocator));
+            allocator_traits::deallocate(alloc, static_cast<std::byte*>(ptr), size);
         }
     }
 };
@@ -0,0 +1,443 @@
+// include/beman/task/detail/async_single_flight.hpp                  -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ASYNC_SINGLE_FLIGHT
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ASYNC_SINGLE_FLIGHT
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/task.hpp>
+#include <beman/task/detail/task_scheduler.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Coalesce concurrent asynchronous loads of the same key
+ * \headerfile beman/task/async_single_flight.hpp <beman/task/async_single_flight.hpp>
+ *
+ * The sender `flight.get(key)` completes with the value produced by the
+ * loader for `key`. If a load for `key` is already running, the request
+ * is attached to the running load instead of starting another one, i.e.,
+ * concurrent requests for the same key share one loader task. The keys are
+ * distributed over a number of independently locked shards to avoid
+ * contention between unrelated keys.
+ *
+ * If a time-to-live is specified, successfully loaded values are cached
+ * for that duration and requests for a cached key complete immediately.
+ * Errors and cancellations are never cached. Expired values are removed
+ * when their key is requested again and, to bound the cache for a changing
+ * set of keys, when a value is inserted into a shard whose cache doubled
+ * in size since the expired values were last removed from it.
+ *
+ * A request can be cancelled using the stop token of its receiver: it
+ * then completes with `set_stopped()`. Once every request attached to a
+ * load is gone, stop is requested on the load and the key is removed from
+ * the set of running loads such that later requests start a new load.
+ *
+ * The loader is passed a reference to a copy of the key which stays valid
+ * until the load completes. The loader tasks are run with an environment
+ * providing the scheduler passed upon construction. The object has to
+ * outlive all loads it started.
+ *
+ * Completion signatures:
+ * - `set_value_t(Value)`
+ * - `set_error_t(std::exception_ptr)`
+ * - `set_stopped_t()`
+ *
+ * Usage:
+ *
+ *     async_single_flight<std::string, page> flight(sched, [](const auto& url) { return fetch(url); });
+ *     auto p{co_await flight.get("https://example.com")};
+ */
+template <typename Key,
+          typename Value,
+          typename Context = ::beman::task::detail::default_environment,
+          typename Hash    = ::std::hash<Key>>
+class async_single_flight {
+    static_assert(not ::std::same_as<Value, void>, "async_single_flight requires a non-void value type");
+
+  public:
+    using key_type    = Key;
+    using value_type  = Value;
+    using task_type   = ::beman::task::detail::task<Value, Context>;
+    using loader_type = ::std::function<task_type(const Key&)>;
+    using clock_type  = ::std::chrono::steady_clock;
+    using duration    = clock_type::duration;
+
+    static constexpr ::std::size_t shard_count{16u};
+
+  private:
+    // monostate: stopped, Value: the loaded value, exception_ptr: an error
+    using result_t = ::std::variant<::std::monostate, Value, ::std::exception_ptr>;
+
+    struct entry;
+    struct shard;
+
+    struct waiter {
+        enum class phase : unsigned char { idle, attached, stopped, done };
+
+        shard*  sh;
+        entry*  load{};
+        waiter* next{};
+        waiter* prev{};
+        phase   at{phase::idle};
+
+        explicit waiter(shard* s) : sh(s) {}
+        virtual auto complete(const result_t&) noexcept -> void = 0;
+
+      protected:
+        ~waiter() = default;
+    };
+
+    struct cached {
+        Value                  value;
+        clock_type::time_point expiry;
+    };
+
+    // Shards are aligned to avoid false sharing between their mutexes.
+    struct alignas(64) shard {
+        static constexpr ::std::size_t min_prune{16u};
+
+        ::std::mutex                            mutex;
+        ::std::unordered_map<Key, entry*, Hash> loads;
+        ::std::unordered_map<Key, cached, Hash> cache;
+        ::std::size_t                           prune_at{shard::min_prune};
+
+        // Remove the expired values once the cache reaches prune_at entries.
+        // Doubling the limit relative to the remaining entries keeps the
+        // amortized cost per insertion constant.
+        auto prune(clock_type::time_point now) -> void {
+            if (this->prune_at <= this->cache.size()) {
+                ::std::erase_if(this->cache, [now](const auto& value) { return not(now < value.second.expiry); });
+                this->prune_at = ::std::max(shard::min_prune, 2u * this->cache.size());
+            }
+        }
+    };
+
+    struct entry {
+        struct env {
+            entry* e;
+            auto   query(const ::beman::execution::get_stop_token_t&) const noexcept
+                -> ::beman::execution::inplace_stop_token {
+                return this->e->source.get_token();
+            }
+            auto query(const ::beman::execution::get_scheduler_t&) const noexcept
+                -> ::beman::task::detail::task_scheduler {
+                return this->e->owner->scheduler;
+            }
+        };
+        struct receiver {
+            using receiver_concept = ::beman::execution::receiver_t;
+            entry* e;
+
+            template <typename V>
+            auto set_value(V&& value) && noexcept -> void {
+                BEMAN_TASK_TRY {
+                    this->e->owner->finish(this->e, result_t(::std::in_place_index<1u>, ::std::forward<V>(value)));
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    this->e->owner->finish(this->e, result_t(::std::in_place_index<2u>, ::std::current_exception()));
+                }
+            }
+            template <typename E>
+            auto set_error(E&& error) && noexcept -> void {
+                if constexpr (::std::same_as<::std::remove_cvref_t<E>, ::std::exception_ptr>) {
+                    this->e->owner->finish(this->e, result_t(::std::in_place_index<2u>, ::std::forward<E>(error)));
+                } else {
+                    this->e->owner->finish(
+                        this->e,
+                        result_t(::std::in_place_index<2u>, ::std::make_exception_ptr(::std::forward<E>(error))));
+                }
+            }
+            auto set_stopped() && noexcept -> void { this->e->owner->finish(this->e, result_t()); }
+            auto get_env() const noexcept -> env { return {this->e}; }
+        };
+        using op_t = decltype(::beman::execution::connect(::std::declval<task_type>(), ::std::declval<receiver>()));
+        // The operation state is created in place as it may not be movable.
+        struct load {
+            op_t op;
+            explicit load(entry* e) : op(::beman::execution::connect(e->owner->loader(e->key), receiver{e})) {}
+        };
+
+        async_single_flight*                    owner;
+        Key                                     key;
+        ::beman::execution::inplace_stop_source source;
+        waiter*                                 head{};
+        ::std::optional<load>                   running;
+
+        entry(async_single_flight* o, const Key& k) : owner(o), key(k) {}
+
+        auto attach(waiter* w) noexcept -> void {
+            w->load = this;
+            w->at   = waiter::phase::attached;
+            w->prev = nullptr;
+            w->next = ::std::exchange(this->head, w);
+            if (w->next) {
+                w->next->prev = w;
+            }
+        }
+        auto detach(waiter* w) noexcept -> void {
+            (w->prev ? w->prev->next : this->head) = w->next;
+            if (w->next) {
+                w->next->prev = w->prev;
+            }
+        }
+    };
+
+    template <typename Receiver>
+    struct state : waiter {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        struct stopper {
+            state* st;
+            auto   operator()() const noexcept -> void { this->st->owner->cancel(this->st); }
+        };
+        using stop_token_t =
+            decltype(::beman::execution::get_stop_token(::beman::execution::get_env(::std::declval<Receiver&>())));
+        using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stopper>;
+
+        async_single_flight*             owner;
+        Key                              key;
+        Receiver                         receiver;
+        ::std::optional<stop_callback_t> callback;
+
+        template <typename R>
+        state(async_single_flight* o, Key&& k, R&& r)
+            : waiter(&o->shard_for(k)), owner(o), key(::std::move(k)), receiver(::std::forward<R>(r)) {}
+        state(state&&) = delete;
+
+        auto start() & noexcept -> void {
+            auto token{::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver))};
+            if (token.stop_requested()) {
+                ::beman::execution::set_stopped(::std::move(this->receiver));
+                return;
+            }
+            this->callback.emplace(token, stopper{this});
+            this->owner->subscribe(this, this->key);
+        }
+        auto complete(const result_t& result) noexcept -> void override {
+            this->callback.reset();
+            switch (result.index()) {
+            case 0u:
+                ::beman::execution::set_stopped(::std::move(this->receiver));
+                break;
+            case 1u:
+                ::beman::execution::set_value(::std::move(this->receiver), ::std::get<1u>(result));
+                break;
+            default:
+                ::beman::execution::set_error(::std::move(this->receiver), ::std::get<2u>(result));
+                break;
+            }
+        }
+    };
+
+    class sender {
+      public:
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t(Value),
+                                                                                ::beman::execution::set_error_t(
+                                                                                    ::std::exception_ptr),
+                                                                                ::beman::execution::set_stopped_t()>;
+
+        sender(async_single_flight* o, Key k) : owner(o), key(::std::move(k)) {}
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) && -> state<::std::remove_cvref_t<Receiver>> {
+            return state<::std::remove_cvref_t<Receiver>>(
+                this->owner, ::std::move(this->key), ::std::forward<Receiver>(receiver));
+        }
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) const& -> state<::std::remove_cvref_t<Receiver>> {
+            return state<::std::remove_cvref_t<Receiver>>(
+                this->owner, Key(this->key), ::std::forward<Receiver>(receiver));
+        }
+
+      private:
+        async_single_flight* owner;
+        Key                  key;
+    };
+
+    auto shard_for(const Key& key) -> shard& { return this->shards[this->hash(key) % shard_count]; }
+
+    /*
+     * \brief Attach a waiter to a load for key, starting the load if needed.
+     *
+     * The entry for a new load is registered while holding the shard's
+     * lock but the loader is invoked and its task is connected and started
+     * only after the lock is released: the loader may do real work or
+     * request keys of the same shard. Requests arriving in between attach
+     * to the registered entry. If the loader or connect fails, all
+     * attached requests complete with the error.
+     */
+    auto subscribe(waiter* w, const Key& key) noexcept -> void {
+        ::std::optional<result_t> immediate;
+        entry*                    created{};
+        {
+            ::std::lock_guard guard(w->sh->mutex);
+            if (w->at == waiter::phase::stopped) {
+                immediate.emplace();
+            } else if (auto it{w->sh->cache.find(key)};
+                       it != w->sh->cache.end() && clock_type::now() < it->second.expiry) {
+                BEMAN_TASK_TRY {
+                    immediate.emplace(::std::in_place_index<1u>, it->second.value);
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    immediate.emplace(::std::in_place_index<2u>, ::std::current_exception());
+                }
+            } else if (auto lit{w->sh->loads.find(key)}; lit != w->sh->loads.end()) {
+                lit->second->attach(w);
+            } else {
+                BEMAN_TASK_TRY {
+                    if (it != w->sh->cache.end()) {
+                        w->sh->cache.erase(it);
+                    }
+                    created = new entry(this, key);
+                    w->sh->loads.emplace(key, created);
+                    created->attach(w);
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    delete created;
+                    created = nullptr;
+                    immediate.emplace(::std::in_place_index<2u>, ::std::current_exception());
+                }
+            }
+            if (immediate) {
+                w->at = waiter::phase::done;
+            }
+        }
+        if (immediate) {
+            w->complete(*immediate);
+        } else if (created) {
+            BEMAN_TASK_TRY {
+                created->running.emplace(created);
+            }
+            BEMAN_TASK_CATCH_ALL {
+                this->finish(created, result_t(::std::in_place_index<2u>, ::std::current_exception()));
+                return;
+            }
+            ::beman::execution::start(created->running->op);
+        }
+    }
+
+    /*
+     * \brief Detach a waiter whose stop token got triggered.
+     *
+     * If this was the last waiter of a load, the load is abandoned: it is
+     * asked to stop and removed from the running loads.
+     */
+    auto cancel(waiter* w) noexcept -> void {
+        entry* abandoned{};
+        bool   attached{false};
+        {
+            ::std::lock_guard guard(w->sh->mutex);
+            if (w->at == waiter::phase::idle) {
+                w->at = waiter::phase::stopped;
+            } else if (w->at == waiter::phase::attached) {
+                attached = true;
+                w->at    = waiter::phase::done;
+                w->load->detach(w);
+                if (w->load->head == nullptr) {
+                    abandoned = w->load;
+                    w->sh->loads.erase(abandoned->key);
+                }
+            }
+        }
+        if (abandoned) {
+            abandoned->source.request_stop();
+        }
+        if (attached) {
+            w->complete(result_t());
+        }
+    }
+
+    auto finish(entry* e, result_t&& result) noexcept -> void {
+        waiter* head{};
+        {
+            shard&            sh{this->shard_for(e->key)};
+            ::std::lock_guard guard(sh.mutex);
+            if (auto it{sh.loads.find(e->key)}; it != sh.loads.end() && it->second == e) {
+                sh.loads.erase(it);
+            }
+            if (result.index() == 1u && this->ttl != duration::zero()) {
+                BEMAN_TASK_TRY {
+                    const clock_type::time_point now{clock_type::now()};
+                    sh.prune(now);
+                    sh.cache.insert_or_assign(e->key, cached{::std::get<1u>(result), now + this->ttl});
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    // failing to cache a value isn't an error for the waiters
+                }
+            }
+            head = ::std::exchange(e->head, nullptr);
+            for (waiter* w{head}; w != nullptr; w = w->next) {
+                w->at = waiter::phase::done;
+            }
+        }
+        // Completing a waiter may destroy it: the next pointer is read first.
+        while (head) {
+            ::std::exchange(head, head->next)->complete(result);
+        }
+        delete e;
+    }
+
+    ::beman::task::detail::task_scheduler scheduler;
+    loader_type                           loader;
+    duration                              ttl;
+    Hash                                  hash{};
+    ::std::array<shard, shard_count>      shards;
+
+  public:
+    template <::beman::execution::scheduler Scheduler>
+    async_single_flight(Scheduler&& sched, loader_type ld, duration t = duration::zero())
+        : scheduler(::std::forward<Scheduler>(sched)), loader(::std::move(ld)), ttl(t) {}
+    async_single_flight(const async_single_flight&)            = delete;
+    async_single_flight& operator=(const async_single_flight&) = delete;
+    ~async_single_flight()                                     = default;
+
+    /*!
+     * \brief Get a sender producing the value for the key.
+     */
+    auto get(Key key) -> sender { return sender(this, ::std::move(key)); }
+
+    /*!
+     * \brief Remove all cached values.
+     */
+    auto clear_cache() -> void {
+        for (auto& sh : this->shards) {
+            ::std::lock_guard guard(sh.mutex);
+            sh.cache.clear();
+            sh.prune_at = shard::min_prune;
+        }
+    }
+
+    /*!
+     * \brief Get the number of cached values, including expired values not yet removed.
+     */
+    auto cache_size() -> ::std::size_t {
+        ::std::size_t rc{};
+        for (auto& sh : this->shards) {
+            ::std::lock_guard guard(sh.mutex);
+            rc += sh.cache.size();
+        }
+        return rc;
+    }
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -5,8 +5,12 @@
 #define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_AWAITER
 
 #include <beman/task/detail/handle.hpp>
+#include <beman/task/detail/resume_by_reference_of.hpp>
 #include <beman/task/detail/state_base.hpp>
+#include <beman/task/detail/trace.hpp>
+#include <cassert>
 #include <coroutine>
+#include <type_traits>
 #include <utility>
 
 // ----------------------------------------------------------------------------
@@ -44,13 +48,61 @@ struct awaiter_op_t<Awaiter, ParentPromise, false> {
     auto start() noexcept -> void {}
 };
 
+/*!
+ * \brief Storage of the context of a `co_await`ed task
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * The context is constructed from the awaiting coroutine's environment
+ * exactly like `state_rep` constructs it from the receiver's environment
+ * when the task is connected:
+ * 1. If `C::env_type<ParentEnv>` is a type, an object of this type is
+ *    constructed from the environment and the context is constructed
+ *    from a reference to it.
+ * 2. Otherwise, if `C` is constructible from the environment, it is
+ *    constructed from the environment.
+ * 3. Otherwise, `C` is default constructed.
+ */
+template <typename C, typename ParentEnv>
+struct awaiter_context {
+    C context;
+    explicit awaiter_context(const ParentEnv&) : context() {}
+};
+template <typename C, typename ParentEnv>
+    requires requires(const ParentEnv& env) { C(env); } &&
+             (not requires { typename C::template env_type<ParentEnv>; })
+struct awaiter_context<C, ParentEnv> {
+    C context;
+    explicit awaiter_context(const ParentEnv& env) : context(env) {}
+};
+template <typename C, typename ParentEnv>
+    requires requires { typename C::template env_type<ParentEnv>; }
+struct awaiter_context<C, ParentEnv> {
+    typename C::template env_type<ParentEnv> own_env;
+    C                                        context;
+    explicit awaiter_context(const ParentEnv& env) : own_env(env), context(this->own_env) {}
+};
+
 template <typename Value, typename Env, typename OwnPromise, typename ParentPromise>
 class awaiter : public ::beman::task::detail::state_base<Value, Env> {
   public:
     using stop_token_type = typename ::beman::task::detail::state_base<Value, Env>::stop_token_type;
     using scheduler_type  = typename ::beman::task::detail::state_base<Value, Env>::scheduler_type;
 
-    explicit awaiter(::beman::task::detail::handle<OwnPromise> h) : handle(::std::move(h)) {}
+    using parent_env_type =
+        ::std::remove_cvref_t<decltype(::beman::execution::get_env(::std::declval<ParentPromise&>()))>;
+
+    /*
+     * \brief Create the awaiter, initializing the context from the parent's environment.
+     *
+     * The context is constructed like for a connected task, using the
+     * awaiting coroutine's environment in place of the receiver's
+     * environment (see `awaiter_context`). This way forwarding queries
+     * answered by the parent's context, e.g., `get_deadline`, can be
+     * inherited by the awaited task.
+     */
+    awaiter(::beman::task::detail::handle<OwnPromise> h, const parent_env_type& parent_env)
+        : env(parent_env), handle(::std::move(h)) {}
     constexpr auto await_ready() const noexcept -> bool { return false; }
     auto           await_suspend(::std::coroutine_handle<ParentPromise> parent) noexcept {
         this->scheduler.emplace(
@@ -59,7 +111,13 @@ class awaiter : public ::beman::task::detail::state_base<Value, Env> {
         assert(this->parent);
         return this->handle.start(this);
     }
-    auto await_resume() { return this->result_resume(); }
+    auto await_resume() -> decltype(auto) {
+        if constexpr (::beman::task::detail::resume_by_reference_of_v<Env>) {
+            return this->result_resume_reference();
+        } else {
+            return this->result_resume();
+        }
+    }
 
   private:
     friend struct awaiter_scheduler_receiver<awaiter>;
@@ -72,29 +130,47 @@ class awaiter : public ::beman::task::detail::state_base<Value, Env> {
                       }) {
             if (*this->scheduler !=
                 ::beman::execution::get_scheduler(::beman::execution::get_env(this->parent.promise()))) {
+                ::beman::task::detail::trace("awaiter rescheduled", this);
+                this->reschedule.emplace(this->parent.promise(), this);
+                this->reschedule->start();
+                return ::std::noop_coroutine();
+            }
+        }
+        if constexpr (requires { this->parent.promise().consume_inline_resumption(); }) {
+            if (not this->parent.promise().consume_inline_resumption()) {
                 this->reschedule.emplace(this->parent.promise(), this);
                 this->reschedule->start();
-                std::cout << "awaiter rescheduled()\n";
                 return ::std::noop_coroutine();
             }
         }
         return this->actual_complete();
     }
     auto actual_complete() -> std::coroutine_handle<> {
-        return this->no_completion_set() ? this->parent.promise().unhandled_stopped() : ::std::move(this->parent);
+        if (this->no_completion_set()) {
+            return this->parent.promise().unhandled_stopped();
+        }
+        // Errors the parent opted to complete with are forwarded without a throw.
+        std::coroutine_handle<> next{};
+        auto                    forward{[this, &next]<typename E, typename P = ParentPromise>(E&& error)
+                         requires requires(P& p, E& e) { p.forward_error(::std::move(e)); }
+                     { next = static_cast<P&>(this->parent.promise()).forward_error(::std::move(error)); }};
+        if (this->result_forward_error(forward)) {
+            return next;
+        }
+        return ::std::move(this->parent);
     }
     auto do_get_scheduler() -> scheduler_type override { return *this->scheduler; }
     auto do_set_scheduler(scheduler_type other) -> scheduler_type override {
         return ::std::exchange(*this->scheduler, other);
     }
     auto do_get_stop_token() -> stop_token_type override { return {}; }
-    auto do_get_environment() -> Env& override { return this->env; }
+    auto do_get_environment() -> Env& override { return this->env.context; }
 
-    Env                                                   env;
-    ::std::optional<scheduler_type>                       scheduler;
-    ::beman::task::detail::handle<OwnPromise>             handle;
-    ::std::coroutine_handle<ParentPromise>                parent{};
-    ::std::optional<awaiter_op_t<awaiter, ParentPromise>> reschedule{};
+    ::beman::task::detail::awaiter_context<Env, parent_env_type> env;
+    ::std::optional<scheduler_type>                              scheduler;
+    ::beman::task::detail::handle<OwnPromise>                    handle;
+    ::std::coroutine_handle<ParentPromise>                       parent{};
+    ::std::optional<awaiter_op_t<awaiter, ParentPromise>>        reschedule{};
 };
 } // namespace beman::task::detail
 
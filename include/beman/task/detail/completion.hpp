@@ -21,6 +21,18 @@ struct completion<void> {
 template <typename R>
 using completion_t = typename beman::task::detail::completion<R>::type;
 
+template <typename R>
+struct shared_completion {
+    using type = ::beman::execution::set_value_t(const R&);
+};
+template <>
+struct shared_completion<void> {
+    using type = ::beman::execution::set_value_t();
+};
+
+template <typename R>
+using shared_completion_t = typename beman::task::detail::shared_completion<R>::type;
+
 } // namespace beman::task::detail
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,211 @@
+// include/beman/task/detail/detached_task.hpp                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_DETACHED_TASK
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_DETACHED_TASK
+
+#include <beman/task/detail/affine_on.hpp>
+#include <beman/task/detail/allocator_of.hpp>
+#include <beman/task/detail/allocator_support.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/find_allocator.hpp>
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+#include <beman/task/detail/frame_registry.hpp>
+#endif
+#include <beman/task/detail/promise_env.hpp>
+#include <beman/task/detail/scheduler_of.hpp>
+#include <beman/task/detail/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <concepts>
+#include <coroutine>
+#include <optional>
+#include <source_location>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Concept for scopes tracking `detached_task`s, e.g., `task_scope`
+ * \headerfile beman/task/detached_task.hpp <beman/task/detached_task.hpp>
+ */
+template <typename Scope>
+concept detached_scope = requires(Scope& scope) {
+    scope.retain();
+    scope.release();
+    { scope.get_stop_token() } -> ::std::convertible_to<::beman::execution::inplace_stop_token>;
+};
+
+/*!
+ * \brief Eagerly started coroutine type without an operation state
+ * \headerfile beman/task/detached_task.hpp <beman/task/detached_task.hpp>
+ *
+ * Calling a coroutine returning `detached_task<C>` schedules the
+ * coroutine on the first argument which is a scheduler. The object
+ * returned from the call has no use: the coroutine frame owns itself
+ * and is destroyed when the coroutine completes. Unlike spawning a
+ * `task` into a scope neither an operation state for the `task` nor a
+ * job for the scope is needed: the promise is the only state.
+ *
+ * If one of the arguments is a `detached_scope`, e.g., a `task_scope`,
+ * the coroutine is accounted for by the scope until the frame is
+ * destroyed and the scope's stop token is made available to the
+ * coroutine. When stopped the coroutine is destroyed. If an exception
+ * escapes the coroutine or scheduling the coroutine initially fails,
+ * i.e., the scheduler's sender completes with an error,
+ * `unhandled_failure()` is called: the registered `failure_handler` is
+ * invoked and the program is terminated. The scheduler type,
+ * the allocator type, and additional environment queries are obtained
+ * from the context `C` like for `task`.
+ *
+ * Usage:
+ *
+ *     detached_task<> handle(auto sched, task_scope<>& scope, request r) {
+ *         co_await respond(r);
+ *     }
+ *     handle(sched, scope, std::move(r));
+ */
+template <typename Context = ::beman::task::detail::default_environment>
+class detached_task {
+  public:
+    class promise_type;
+};
+
+template <typename Context>
+class detached_task<Context>::promise_type
+    : public ::beman::task::detail::allocator_support<::beman::task::detail::allocator_of_t<Context>> {
+  public:
+    using allocator_type  = ::beman::task::detail::allocator_of_t<Context>;
+    using scheduler_type  = ::beman::task::detail::scheduler_of_t<Context>;
+    using stop_token_type = ::beman::execution::inplace_stop_token;
+
+    template <typename... A>
+    promise_type(A&... a)
+        : allocator(::beman::task::detail::find_allocator<allocator_type>(a...)),
+          scheduler(promise_type::find_scheduler(a...)) {
+        promise_type::find_scope(this, a...);
+    }
+    promise_type(const promise_type&)            = delete;
+    promise_type& operator=(const promise_type&) = delete;
+
+    auto get_return_object([[maybe_unused]] const ::std::source_location& location =
+                               ::std::source_location::current()) noexcept -> detached_task {
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+        ::beman::task::detail::frame_registry::instance().identify(
+            ::std::coroutine_handle<promise_type>::from_promise(*this).address(), location);
+#endif
+        return {};
+    }
+    auto initial_suspend() noexcept { return schedule_awaiter{}; }
+    auto final_suspend() noexcept { return destroy_awaiter{}; }
+    auto return_void() noexcept -> void {}
+    auto unhandled_exception() noexcept -> void { ::beman::task::detail::unhandled_failure(); }
+    auto unhandled_stopped() noexcept -> ::std::coroutine_handle<> {
+        promise_type::destroy(::std::coroutine_handle<promise_type>::from_promise(*this));
+        return ::std::noop_coroutine();
+    }
+
+    template <::beman::execution::sender Sender>
+    auto await_transform(Sender&& sender) noexcept {
+        if constexpr (requires {
+                          ::std::forward<Sender>(sender).as_awaitable(*this);
+                          typename ::std::remove_cvref_t<Sender>::task_concept;
+                      }) {
+            return ::std::forward<Sender>(sender).as_awaitable(*this);
+        } else {
+            return ::beman::execution::as_awaitable(
+                ::beman::task::affine_on(::std::forward<Sender>(sender), this->get_scheduler()), *this);
+        }
+    }
+
+    auto get_env() const noexcept -> ::beman::task::detail::promise_env<promise_type> { return {this}; }
+    auto get_scheduler() const noexcept -> scheduler_type { return this->scheduler; }
+    auto get_allocator() const noexcept -> allocator_type { return this->allocator; }
+    auto get_stop_token() const noexcept -> stop_token_type { return this->token; }
+    auto get_environment() const noexcept -> const Context& { return this->environment; }
+
+  private:
+    struct receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        promise_type* promise;
+
+        auto set_value() && noexcept -> void {
+            ::std::coroutine_handle<promise_type>::from_promise(*this->promise).resume();
+        }
+        // The coroutine can't observe the error: it never started.
+        auto set_error(auto&&) && noexcept -> void { ::beman::task::detail::unhandled_failure(); }
+        auto set_stopped() && noexcept -> void { this->promise->unhandled_stopped(); }
+        auto get_env() const noexcept -> ::beman::task::detail::promise_env<promise_type> { return {this->promise}; }
+    };
+    struct schedule_state {
+        using state_t = decltype(::beman::execution::connect(
+            ::beman::execution::schedule(::std::declval<scheduler_type&>()), ::std::declval<receiver>()));
+
+        explicit schedule_state(promise_type* p)
+            : state(::beman::execution::connect(::beman::execution::schedule(p->scheduler), receiver{p})) {}
+        state_t state;
+    };
+
+    struct schedule_awaiter {
+        static constexpr auto await_ready() noexcept -> bool { return false; }
+        static auto           await_suspend(::std::coroutine_handle<promise_type> handle) noexcept -> void {
+            promise_type& p{handle.promise()};
+            ::beman::execution::start(p.start.emplace(&p).state);
+        }
+        static constexpr auto await_resume() noexcept -> void {}
+    };
+    struct destroy_awaiter {
+        static constexpr auto await_ready() noexcept -> bool { return false; }
+        static auto           await_suspend(::std::coroutine_handle<promise_type> handle) noexcept -> void {
+            promise_type::destroy(handle);
+        }
+        static constexpr auto await_resume() noexcept -> void {}
+    };
+
+    template <typename A0, typename... A>
+    static auto find_scheduler(A0& a0, A&... a) -> scheduler_type {
+        if constexpr (::beman::execution::scheduler<A0>) {
+            return scheduler_type(a0);
+        } else if constexpr (0u < sizeof...(A)) {
+            return promise_type::find_scheduler(a...);
+        } else {
+            static_assert(::beman::execution::scheduler<A0>, "a detached_task needs a scheduler argument");
+        }
+    }
+    static auto find_scope(promise_type*) noexcept -> void {}
+    template <typename A0, typename... A>
+    static auto find_scope(promise_type* self, A0& a0, A&... a) noexcept -> void {
+        if constexpr (::beman::task::detail::detached_scope<A0>) {
+            a0.retain();
+            self->scope   = &a0;
+            self->release = [](void* s) noexcept { static_cast<A0*>(s)->release(); };
+            self->token   = a0.get_stop_token();
+        } else {
+            promise_type::find_scope(self, a...);
+        }
+    }
+    static auto destroy(::std::coroutine_handle<promise_type> handle) noexcept -> void {
+        // The scope may be destroyed once released: release it last.
+        void* s{handle.promise().scope};
+        auto  r{handle.promise().release};
+        handle.destroy();
+        if (s) {
+            r(s);
+        }
+    }
+
+    allocator_type                  allocator;
+    scheduler_type                  scheduler;
+    stop_token_type                 token{};
+    void*                           scope{};
+    void                            (*release)(void*) noexcept {};
+    Context                         environment{};
+    ::std::optional<schedule_state> start;
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
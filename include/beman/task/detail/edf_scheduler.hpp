@@ -0,0 +1,257 @@
+// include/beman/task/detail/edf_scheduler.hpp                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EDF_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EDF_SCHEDULER
+
+#include <beman/task/detail/get_deadline.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Worker pool executing work earliest deadline first
+ * \headerfile beman/task/edf_scheduler.hpp <beman/task/edf_scheduler.hpp>
+ *
+ * An `edf_context` runs a number of worker threads, each with its own
+ * heap of work ordered by deadline (work with the same deadline is run in
+ * FIFO order). Work scheduled from a worker thread is queued on that
+ * worker's heap, other work is distributed round robin. Idle workers take
+ * work from other workers' heaps: they sleep until work is queued
+ * anywhere and then look at all heaps.
+ *
+ * The deadline of scheduled work is obtained using `get_deadline` from
+ * the receiver's environment, also when scheduling through a
+ * `task_scheduler`. Work without deadline is run after all work
+ * with a deadline. Work whose deadline has passed when it gets to the top
+ * of a heap isn't run: it completes with `set_stopped()` instead.
+ *
+ * Usage:
+ *
+ *     edf_context pool(4);
+ *     ex::sync_wait(ex::starts_on(pool.get_scheduler(), handle(request)));
+ */
+class edf_context {
+  public:
+    using clock_type = ::std::chrono::steady_clock;
+
+    class scheduler;
+
+    explicit edf_context(::std::size_t threads = 1u)
+        : count(::std::max(threads, ::std::size_t(1u))), workers(new worker[this->count]) {
+        for (::std::size_t i{}; i != this->count; ++i) {
+            this->threads.emplace_back([this, i] { this->run(i); });
+        }
+    }
+    edf_context(const edf_context&)            = delete;
+    edf_context& operator=(const edf_context&) = delete;
+    ~edf_context() {
+        this->finish();
+        for (auto& thread : this->threads) {
+            thread.join();
+        }
+    }
+
+    auto get_scheduler() -> scheduler;
+    /*!
+     * \brief Let the workers exit once all queued work is done.
+     */
+    auto finish() -> void {
+        {
+            ::std::lock_guard guard(this->idle_mutex);
+            this->done = true;
+        }
+        this->idle_condition.notify_all();
+    }
+
+  private:
+    struct node {
+        clock_type::time_point deadline{};
+        ::std::uint64_t        sequence{};
+        virtual auto           run() noexcept -> void    = 0;
+        virtual auto           expire() noexcept -> void = 0;
+
+      protected:
+        ~node() = default;
+    };
+    // Comparison for std::push_heap/std::pop_heap putting the earliest deadline on top.
+    struct later {
+        auto operator()(const node* a, const node* b) const noexcept -> bool {
+            return a->deadline != b->deadline ? b->deadline < a->deadline : b->sequence < a->sequence;
+        }
+    };
+    // Workers are aligned to avoid false sharing between their mutexes.
+    struct alignas(64) worker {
+        ::std::mutex         mutex;
+        ::std::vector<node*> heap;
+    };
+    struct current {
+        const edf_context* context{};
+        ::std::size_t      index{};
+    };
+    static auto this_thread() noexcept -> current& {
+        static thread_local current cur{};
+        return cur;
+    }
+
+    auto push(node* n, clock_type::time_point deadline) -> void {
+        n->deadline = deadline;
+        n->sequence = this->sequence.fetch_add(1u, ::std::memory_order_relaxed);
+        const current& cur{edf_context::this_thread()};
+        worker&        w{this->workers[cur.context == this ? cur.index
+                                                           : this->next.fetch_add(1u, ::std::memory_order_relaxed) %
+                                                                 this->count]};
+        {
+            ::std::lock_guard guard(w.mutex);
+            w.heap.push_back(n);
+            ::std::push_heap(w.heap.begin(), w.heap.end(), later{});
+        }
+        // A sleeping worker either sees the new epoch before it waits or,
+        // as it is counted in sleepers, is notified.
+        this->epoch.fetch_add(1u);
+        if (this->sleepers.load() != 0u) {
+            ::std::lock_guard guard(this->idle_mutex);
+            this->idle_condition.notify_one();
+        }
+    }
+    static auto take(worker& w) -> node* {
+        ::std::pop_heap(w.heap.begin(), w.heap.end(), later{});
+        node* n{w.heap.back()};
+        w.heap.pop_back();
+        return n;
+    }
+    // The heaps are locked, not tried, to not miss work a wakeup was sent for.
+    auto steal(::std::size_t self) -> node* {
+        for (::std::size_t i{1u}; i != this->count; ++i) {
+            worker&           w{this->workers[(self + i) % this->count]};
+            ::std::lock_guard guard(w.mutex);
+            if (not w.heap.empty()) {
+                return edf_context::take(w);
+            }
+        }
+        return nullptr;
+    }
+    auto pop(::std::size_t self) -> node* {
+        worker& own{this->workers[self]};
+        while (true) {
+            ::std::uint64_t seen{this->epoch.load()};
+            {
+                ::std::lock_guard guard(own.mutex);
+                if (not own.heap.empty()) {
+                    return edf_context::take(own);
+                }
+            }
+            if (node* n{this->steal(self)}) {
+                return n;
+            }
+            ::std::unique_lock guard(this->idle_mutex);
+            if (this->done) {
+                ::std::lock_guard own_guard(own.mutex);
+                if (own.heap.empty()) {
+                    return nullptr;
+                }
+                continue;
+            }
+            ++this->sleepers;
+            this->idle_condition.wait(guard, [this, seen] { return this->done || this->epoch.load() != seen; });
+            --this->sleepers;
+        }
+    }
+    auto run(::std::size_t self) -> void {
+        edf_context::this_thread() = current{this, self};
+        while (node* n = this->pop(self)) {
+            if (n->deadline < clock_type::now()) {
+                n->expire();
+            } else {
+                n->run();
+            }
+        }
+    }
+
+    ::std::size_t                  count;
+    ::std::unique_ptr<worker[]>    workers;
+    ::std::atomic<::std::size_t>   next{};
+    ::std::atomic<::std::uint64_t> sequence{};
+    ::std::mutex                   idle_mutex;
+    ::std::condition_variable      idle_condition;
+    ::std::atomic<::std::uint64_t> epoch{};
+    ::std::atomic<::std::size_t>   sleepers{};
+    bool                           done{false};
+    ::std::vector<::std::thread>   threads;
+};
+
+/*!
+ * \brief Scheduler of an `edf_context`
+ * \headerfile beman/task/edf_scheduler.hpp <beman/task/edf_scheduler.hpp>
+ */
+class edf_context::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    struct env {
+        edf_context* context;
+
+        auto query(const ::beman::execution::get_completion_scheduler_t<::beman::execution::set_value_t>&)
+            const noexcept -> scheduler {
+            return scheduler(this->context);
+        }
+    };
+    template <::beman::execution::receiver Receiver>
+    struct state : edf_context::node {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        ::std::remove_cvref_t<Receiver> receiver;
+        edf_context*                    context;
+
+        template <typename R>
+        state(R&& r, edf_context* c) : receiver(::std::forward<R>(r)), context(c) {}
+        auto start() & noexcept -> void {
+            this->context->push(this, ::beman::task::detail::deadline_of(::beman::execution::get_env(this->receiver)));
+        }
+        auto run() noexcept -> void override { ::beman::execution::set_value(::std::move(this->receiver)); }
+        auto expire() noexcept -> void override { ::beman::execution::set_stopped(::std::move(this->receiver)); }
+    };
+    struct sender {
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::
+            completion_signatures<::beman::execution::set_value_t(), ::beman::execution::set_stopped_t()>;
+
+        edf_context* context;
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) const -> state<Receiver> {
+            return state<Receiver>(::std::forward<Receiver>(receiver), this->context);
+        }
+        auto get_env() const noexcept -> env { return {this->context}; }
+    };
+
+    explicit scheduler(edf_context* c) : context(c) {}
+
+    auto schedule() const noexcept -> sender { return {this->context}; }
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    edf_context* context;
+};
+
+inline auto edf_context::get_scheduler() -> scheduler { return scheduler(this); }
+
+using edf_scheduler = ::beman::task::detail::edf_context::scheduler;
+static_assert(::beman::execution::scheduler<edf_scheduler>);
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
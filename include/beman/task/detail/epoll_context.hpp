@@ -0,0 +1,553 @@
+// include/beman/task/detail/epoll_context.hpp                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EPOLL_CONTEXT
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EPOLL_CONTEXT
+
+#if defined(__linux__) && __has_include(<sys/epoll.h>)
+#define BEMAN_TASK_HAS_EPOLL 1
+
+#include <beman/task/detail/eventfd_wakeup.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/execution/execution.hpp>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Execution context notifying about file descriptor readiness using epoll
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ *
+ * An `epoll_context` owns an epoll instance and a thread waiting for
+ * events. The senders `async_wait_readable(scheduler, fd)` and
+ * `async_wait_writable(scheduler, fd)` complete on that thread once `fd`
+ * becomes ready, e.g., for pipes, eventfds, timerfds, or sockets. The
+ * context's scheduler runs work on the same thread: as all completions
+ * of the waits happen on that thread and the senders report the context's
+ * scheduler as their completion scheduler, a `task` using the context's
+ * scheduler resumes directly after a readiness notification, i.e.,
+ * `affine_on` doesn't queue the continuation again.
+ *
+ * File descriptors are registered edge-triggered upon their first wait
+ * and stay registered until `deregister(fd)` is called, which has to
+ * happen before the file descriptor is closed. As with any edge-triggered
+ * interface, a completion only means that the file descriptor may be
+ * ready: the I/O operation should be retried until it fails with
+ * `EAGAIN` before waiting again. An edge seen while nobody waits is
+ * remembered and completes the next wait immediately.
+ *
+ * Requests from any thread are queued and the thread is woken up using an
+ * `eventfd_wakeup`: no system call is needed while the thread is busy,
+ * e.g., for requests made by the continuations it runs. Each round of the
+ * thread calls `epoll_wait` once. Stop requests complete the waiting
+ * operation with `set_stopped()` and failures to register the file
+ * descriptor complete with `set_error(std::error_code)`. Operations still
+ * waiting when the context is destroyed complete with `set_stopped()`.
+ *
+ * This component is only available when `<sys/epoll.h>` is present.
+ *
+ * Usage:
+ *
+ *     epoll_context reactor;
+ *     while (::read(fd, buffer, size) < 0 && errno == EAGAIN) {
+ *         co_await async_wait_readable(reactor.get_scheduler(), fd);
+ *     }
+ */
+class epoll_context {
+  public:
+    class scheduler;
+    class schedule_sender;
+    template <bool Write>
+    class wait_sender;
+
+    epoll_context() {
+        this->poller = ::epoll_create1(EPOLL_CLOEXEC);
+        if (this->poller < 0) {
+            ::beman::task::detail::throw_exception(
+                ::std::system_error(errno, ::std::system_category(), "epoll_create1"));
+        }
+        // Edge-triggered: every write to the eventfd is reported, it is never read.
+        ::epoll_event event{};
+        event.events  = EPOLLIN | EPOLLET;
+        event.data.fd = this->notifier.native_handle();
+        if (::epoll_ctl(this->poller, EPOLL_CTL_ADD, event.data.fd, &event) < 0) {
+            int error{errno};
+            ::close(this->poller);
+            ::beman::task::detail::throw_exception(
+                ::std::system_error(error, ::std::system_category(), "epoll wakeup"));
+        }
+        this->thread = ::std::thread([this] { this->run(); });
+    }
+    epoll_context(const epoll_context&)            = delete;
+    epoll_context& operator=(const epoll_context&) = delete;
+    ~epoll_context() {
+        {
+            ::std::lock_guard guard(this->mutex);
+            this->done = true;
+        }
+        this->notifier.notify();
+        this->thread.join();
+        ::close(this->poller);
+    }
+
+    auto get_scheduler() -> scheduler;
+
+    /*!
+     * \brief Remove the registration of `fd`.
+     *
+     * Operations still waiting for `fd` complete with `set_stopped()`. The
+     * registration is removed asynchronously but before any wait requested
+     * afterwards by the calling thread is processed, i.e., `fd` may be
+     * closed immediately.
+     */
+    auto deregister(int fd) -> void { this->push(new forget_node(this, fd)); }
+
+  private:
+    template <typename Receiver, bool Write>
+    struct state;
+    template <typename Receiver>
+    struct schedule_state;
+
+    // A request processed on the context's thread.
+    struct node {
+        node*        next{};
+        virtual auto run() noexcept -> void = 0;
+
+      protected:
+        ~node() = default;
+    };
+    struct waiters;
+    // An operation waiting for readiness of a file descriptor.
+    struct waiter : node {
+        waiters*     list{};
+        waiter*      before{};
+        waiter*      after{};
+        virtual auto ready(bool cancelled) noexcept -> void = 0;
+
+      protected:
+        ~waiter() = default;
+    };
+    struct waiters {
+        waiter* first{};
+        waiter* last{};
+        bool    ready{false};
+
+        auto push_back(waiter* w) noexcept -> void {
+            w->list   = this;
+            w->before = this->last;
+            w->after  = nullptr;
+            (this->last ? this->last->after : this->first) = w;
+            this->last                                     = w;
+        }
+        auto unlink(waiter* w) noexcept -> void {
+            (w->before ? w->before->after : this->first) = w->after;
+            (w->after ? w->after->before : this->last)   = w->before;
+            w->list                                      = nullptr;
+        }
+        auto complete(bool cancelled) noexcept -> void {
+            waiter* w{::std::exchange(this->first, nullptr)};
+            this->last = nullptr;
+            while (w) {
+                w->list = nullptr;
+                // Completing may destroy the waiter.
+                ::std::exchange(w, w->after)->ready(cancelled);
+            }
+        }
+        auto signal() noexcept -> void {
+            if (this->first) {
+                this->complete(false);
+            } else {
+                this->ready = true;
+            }
+        }
+    };
+    struct descriptor {
+        ::std::array<waiters, 2u> lists{}; // indexed by Write
+    };
+    struct forget_node final : node {
+        epoll_context* context;
+        int            fd;
+        forget_node(epoll_context* c, int f) : context(c), fd(f) {}
+        auto run() noexcept -> void override {
+            this->context->forget(this->fd);
+            delete this;
+        }
+    };
+
+    auto push(node* n) noexcept -> void {
+        n->next = nullptr;
+        {
+            ::std::lock_guard guard(this->mutex);
+            (this->head ? this->tail->next : this->head) = n;
+            this->tail                                   = n;
+        }
+        this->notifier.notify();
+    }
+
+    // The descriptors are only accessed from the context's thread.
+    auto watch(int fd, int& error) noexcept -> descriptor* {
+        if (fd < 0) {
+            error = EBADF;
+            return nullptr;
+        }
+        auto index{::std::size_t(fd)};
+        if (index < this->descriptors.size() && this->descriptors[index]) {
+            return this->descriptors[index].get();
+        }
+        BEMAN_TASK_TRY {
+            if (this->descriptors.size() <= index) {
+                this->descriptors.resize(index + 1u);
+            }
+            this->descriptors[index] = ::std::make_unique<descriptor>();
+        }
+        BEMAN_TASK_CATCH_ALL {
+            error = ENOMEM;
+            return nullptr;
+        }
+        ::epoll_event event{};
+        event.events  = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = fd;
+        if (::epoll_ctl(this->poller, EPOLL_CTL_ADD, fd, &event) < 0) {
+            error = errno;
+            this->descriptors[index].reset();
+            return nullptr;
+        }
+        return this->descriptors[index].get();
+    }
+    auto forget(int fd) noexcept -> void {
+        auto index{::std::size_t(fd)};
+        if (fd < 0 || this->descriptors.size() <= index || not this->descriptors[index]) {
+            return;
+        }
+        ::epoll_ctl(this->poller, EPOLL_CTL_DEL, fd, nullptr);
+        auto d{::std::move(this->descriptors[index])};
+        for (auto& list : d->lists) {
+            list.complete(true);
+        }
+    }
+    auto dispatch(const ::epoll_event& event) noexcept -> void {
+        auto index{::std::size_t(event.data.fd)};
+        // The wakeup is never among the descriptors.
+        if (this->descriptors.size() <= index || not this->descriptors[index]) {
+            return;
+        }
+        descriptor& d{*this->descriptors[index]};
+        if (event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            d.lists[0].signal();
+        }
+        if (event.events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+            d.lists[1].signal();
+        }
+    }
+
+    // Run all queued requests; returns whether the context is shutting down.
+    auto drain() noexcept -> bool {
+        while (true) {
+            node* batch{};
+            bool  stop{};
+            {
+                ::std::lock_guard guard(this->mutex);
+                batch = ::std::exchange(this->head, nullptr);
+                stop  = this->done;
+            }
+            if (batch == nullptr) {
+                return stop;
+            }
+            while (batch) {
+                // Running the node may destroy it.
+                ::std::exchange(batch, batch->next)->run();
+            }
+        }
+    }
+    auto run() -> void {
+        ::std::array<::epoll_event, 64u> events;
+        while (not this->drain()) {
+            // With a pending notification only look for events without blocking.
+            bool block{this->notifier.prepare_wait()};
+            int  count{::epoll_wait(this->poller, events.data(), int(events.size()), block ? -1 : 0)};
+            if (block) {
+                this->notifier.woken();
+            }
+            for (int i{}; i < count; ++i) {
+                this->dispatch(events[::std::size_t(i)]);
+            }
+        }
+        // Completing the remaining waiters may queue cancellations or new requests.
+        while (this->stop_all()) {
+            this->drain();
+        }
+    }
+    auto stop_all() noexcept -> bool {
+        bool any{false};
+        for (auto& d : this->descriptors) {
+            for (::std::size_t i{}; d && i != d->lists.size(); ++i) {
+                any = any || d->lists[i].first != nullptr;
+                d->lists[i].complete(true);
+            }
+        }
+        return any;
+    }
+
+    ::beman::task::detail::eventfd_wakeup        notifier;
+    int                                          poller{-1};
+    ::std::vector<::std::unique_ptr<descriptor>> descriptors;
+
+    ::std::mutex  mutex;
+    node*         head{};
+    node*         tail{};
+    bool          done{false};
+    ::std::thread thread;
+};
+
+/*!
+ * \brief Operation state of `async_wait_readable` and `async_wait_writable`
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ * \internal
+ *
+ * The operation state is queued to the context's thread which links it
+ * into the waiters of the file descriptor. When stop is requested, a
+ * cancel request unlinking the operation is queued, too. The operation
+ * completes once both requests are processed.
+ */
+template <typename Receiver, bool Write>
+struct epoll_context::state : epoll_context::waiter {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+
+    struct cancel_node : epoll_context::node {
+        state* st;
+        explicit cancel_node(state* s) : st(s) {}
+        auto run() noexcept -> void override { this->st->cancel(); }
+    };
+    struct stopper {
+        state* st;
+        auto   operator()() const noexcept -> void {
+            this->st->stopped.store(true, ::std::memory_order_relaxed);
+            this->st->pending.fetch_add(1u, ::std::memory_order_relaxed);
+            this->st->context->push(&this->st->canceller);
+        }
+    };
+    using stop_token_t =
+        decltype(::beman::execution::get_stop_token(::beman::execution::get_env(::std::declval<Receiver&>())));
+    using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stopper>;
+
+    ::std::remove_cvref_t<Receiver>  receiver;
+    epoll_context*                   context;
+    int                              fd;
+    cancel_node                      canceller{this};
+    ::std::optional<stop_callback_t> callback;
+    ::std::atomic<bool>              stopped{false};
+    ::std::atomic<unsigned>          pending{1u};
+    bool                             cancelled{false};
+    int                              error{};
+
+    template <typename R>
+    state(R&& r, epoll_context* c, int f) : receiver(::std::forward<R>(r)), context(c), fd(f) {}
+    state(state&&) = delete;
+
+    auto start() & noexcept -> void {
+        auto token{::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver))};
+        if (token.stop_requested()) {
+            // Completed by the context's thread like all other completions.
+            this->stopped.store(true, ::std::memory_order_relaxed);
+        } else if (token.stop_possible()) {
+            this->callback.emplace(token, stopper{this});
+        }
+        this->context->push(this);
+    }
+    auto run() noexcept -> void override {
+        if (this->stopped.load(::std::memory_order_relaxed)) {
+            this->ready(true);
+            return;
+        }
+        auto* d{this->context->watch(this->fd, this->error)};
+        if (d == nullptr) {
+            this->ready(false);
+            return;
+        }
+        auto& list{d->lists[Write]};
+        if (list.ready) {
+            list.ready = false;
+            this->ready(false);
+        } else {
+            list.push_back(this);
+        }
+    }
+    auto ready(bool c) noexcept -> void override {
+        this->callback.reset();
+        this->cancelled = c;
+        this->finish();
+    }
+    auto cancel() noexcept -> void {
+        if (this->list) {
+            this->list->unlink(this);
+            this->ready(true);
+        }
+        this->finish();
+    }
+    auto finish() noexcept -> void {
+        if (1u != this->pending.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+            return;
+        }
+        if (this->error != 0) {
+            ::beman::execution::set_error(::std::move(this->receiver),
+                                          ::std::error_code(this->error, ::std::system_category()));
+        } else if (this->cancelled) {
+            ::beman::execution::set_stopped(::std::move(this->receiver));
+        } else {
+            ::beman::execution::set_value(::std::move(this->receiver));
+        }
+    }
+};
+
+/*!
+ * \brief Operation state of the `epoll_context` scheduler's sender
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ * \internal
+ */
+template <typename Receiver>
+struct epoll_context::schedule_state : epoll_context::node {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+
+    ::std::remove_cvref_t<Receiver> receiver;
+    epoll_context*                  context;
+
+    template <typename R>
+    schedule_state(R&& r, epoll_context* c) : receiver(::std::forward<R>(r)), context(c) {}
+    schedule_state(schedule_state&&) = delete;
+
+    auto start() & noexcept -> void { this->context->push(this); }
+    auto run() noexcept -> void override { ::beman::execution::set_value(::std::move(this->receiver)); }
+};
+
+/*!
+ * \brief Scheduler of an `epoll_context`
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ */
+class epoll_context::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    // All completions of the context's senders happen on its thread.
+    struct env {
+        epoll_context* context;
+
+        template <typename Tag>
+        auto query(const ::beman::execution::get_completion_scheduler_t<Tag>&) const noexcept -> scheduler {
+            return scheduler(this->context);
+        }
+    };
+
+    explicit scheduler(epoll_context* c) : context(c) {}
+
+    auto schedule() const noexcept -> epoll_context::schedule_sender;
+    template <bool Write>
+    auto wait(int fd) const noexcept -> epoll_context::wait_sender<Write>;
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    epoll_context* context;
+};
+
+/*!
+ * \brief Sender running on the thread of an `epoll_context`
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ */
+class epoll_context::schedule_sender {
+  public:
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t()>;
+
+    explicit schedule_sender(epoll_context* c) : context(c) {}
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) const -> epoll_context::schedule_state<Receiver> {
+        return epoll_context::schedule_state<Receiver>(::std::forward<Receiver>(receiver), this->context);
+    }
+    auto get_env() const noexcept -> epoll_context::scheduler::env { return {this->context}; }
+
+  private:
+    epoll_context* context;
+};
+
+/*!
+ * \brief Sender waiting for a file descriptor to become ready
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ */
+template <bool Write>
+class epoll_context::wait_sender {
+  public:
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t(),
+                                                                            ::beman::execution::set_error_t(
+                                                                                ::std::error_code),
+                                                                            ::beman::execution::set_stopped_t()>;
+
+    wait_sender(epoll_context* c, int f) : context(c), fd(f) {}
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) const -> epoll_context::state<Receiver, Write> {
+        return epoll_context::state<Receiver, Write>(::std::forward<Receiver>(receiver), this->context, this->fd);
+    }
+    auto get_env() const noexcept -> epoll_context::scheduler::env { return {this->context}; }
+
+  private:
+    epoll_context* context;
+    int            fd;
+};
+
+inline auto epoll_context::scheduler::schedule() const noexcept -> epoll_context::schedule_sender {
+    return epoll_context::schedule_sender(this->context);
+}
+template <bool Write>
+inline auto epoll_context::scheduler::wait(int fd) const noexcept -> epoll_context::wait_sender<Write> {
+    return {this->context, fd};
+}
+
+inline auto epoll_context::get_scheduler() -> scheduler { return scheduler(this); }
+
+using epoll_scheduler = ::beman::task::detail::epoll_context::scheduler;
+static_assert(::beman::execution::scheduler<epoll_scheduler>);
+
+/*!
+ * \brief Customization point object waiting until a file descriptor is readable
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ */
+struct async_wait_readable_t {
+    auto operator()(::beman::task::detail::epoll_scheduler sched, int fd) const noexcept {
+        return sched.template wait<false>(fd);
+    }
+};
+
+/*!
+ * \brief Customization point object waiting until a file descriptor is writable
+ * \headerfile beman/task/epoll_context.hpp <beman/task/epoll_context.hpp>
+ */
+struct async_wait_writable_t {
+    auto operator()(::beman::task::detail::epoll_scheduler sched, int fd) const noexcept {
+        return sched.template wait<true>(fd);
+    }
+};
+
+inline constexpr async_wait_readable_t async_wait_readable{};
+inline constexpr async_wait_writable_t async_wait_writable{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+#endif
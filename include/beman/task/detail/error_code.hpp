@@ -0,0 +1,45 @@
+// include/beman/task/detail/error_code.hpp                           -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ERROR_CODE
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ERROR_CODE
+
+#include <concepts>
+#include <system_error>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Concept for error types which can be represented as `std::error_code`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * Besides `std::error_code` itself these are the types for which
+ * `make_error_code(error)` is found, e.g., `std::errc` or error code
+ * enumerations of other libraries. The conversion doesn't allocate.
+ */
+template <typename E>
+concept maps_to_error_code = ::std::same_as<::std::remove_cvref_t<E>, ::std::error_code> || requires(const E& e) {
+    { make_error_code(e) } -> ::std::same_as<::std::error_code>;
+};
+
+/*!
+ * \brief Convert an error to `std::error_code`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+template <::beman::task::detail::maps_to_error_code E>
+auto to_error_code(const E& error) noexcept -> ::std::error_code {
+    if constexpr (::std::same_as<E, ::std::error_code>) {
+        return error;
+    } else {
+        return make_error_code(error);
+    }
+}
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -4,15 +4,30 @@
 #ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ERROR_TYPES_OF
 #define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_ERROR_TYPES_OF
 
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/report_error_codes_of.hpp>
 #include <beman/execution/execution.hpp>
 #include <exception>
+#include <system_error>
+#include <type_traits>
 
 // ----------------------------------------------------------------------------
 
 namespace beman::task::detail {
-template <typename>
+template <typename Context>
 struct error_types_of {
-    using type = ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::exception_ptr)>;
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+    using type = ::std::conditional_t<
+        ::beman::task::detail::report_error_codes_of_v<Context>,
+        ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::error_code),
+                                                  ::beman::execution::set_error_t(::std::exception_ptr)>,
+        ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::exception_ptr)>>;
+#else
+    using type = ::std::conditional_t<
+        ::beman::task::detail::report_error_codes_of_v<Context>,
+        ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::error_code)>,
+        ::beman::execution::completion_signatures<>>;
+#endif
 };
 template <typename Context>
     requires requires { typename Context::error_types; }
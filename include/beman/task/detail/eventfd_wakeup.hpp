@@ -0,0 +1,108 @@
+// include/beman/task/detail/eventfd_wakeup.hpp                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EVENTFD_WAKEUP
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EVENTFD_WAKEUP
+
+#if defined(__linux__) && __has_include(<sys/eventfd.h>)
+#define BEMAN_TASK_HAS_EVENTFD 1
+
+#include <beman/task/detail/exceptions.hpp>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Cross-thread wakeup of a single consumer based on an eventfd
+ * \headerfile beman/task/wakeup_loop.hpp <beman/task/wakeup_loop.hpp>
+ *
+ * Producers call `notify()` after making work available. The consumer
+ * announces that it is about to block using `prepare_wait()` and then
+ * either blocks in `wait()` or in a system call of its own, e.g.,
+ * `epoll_wait` with `native_handle()` registered for `EPOLLIN`, followed
+ * by `woken()`. Unlike a condition variable the wakeup can be multiplexed
+ * with I/O readiness.
+ *
+ * Notifications are coalesced: only a notification while the consumer is
+ * blocked or about to block writes to the eventfd. Notifications while
+ * the consumer is awake or after another notification just mark the
+ * wakeup as pending, which makes the next `prepare_wait()` return `false`.
+ */
+class eventfd_wakeup {
+  public:
+    eventfd_wakeup() : fd(::eventfd(0u, EFD_CLOEXEC | EFD_NONBLOCK)) {
+        if (this->fd < 0) {
+            ::beman::task::detail::throw_exception(::std::system_error(errno, ::std::system_category(), "eventfd"));
+        }
+    }
+    eventfd_wakeup(const eventfd_wakeup&)            = delete;
+    eventfd_wakeup& operator=(const eventfd_wakeup&) = delete;
+    ~eventfd_wakeup() { ::close(this->fd); }
+
+    /*!
+     * \brief The eventfd becoming readable when a blocked consumer is notified.
+     */
+    auto native_handle() const noexcept -> int { return this->fd; }
+
+    /*!
+     * \brief Wake the consumer up unless it is awake or already notified.
+     */
+    auto notify() noexcept -> void {
+        if (this->state.exchange(notified, ::std::memory_order_acq_rel) == sleeping) {
+            ::std::uint64_t       one{1u};
+            [[maybe_unused]] auto rc{::write(this->fd, &one, sizeof(one))};
+        }
+    }
+    /*!
+     * \brief Announce blocking; returns `false` if a notification is pending.
+     *
+     * When `false` is returned the notification is consumed and the consumer
+     * should look for work instead of blocking.
+     */
+    auto prepare_wait() noexcept -> bool {
+        int expected{awake};
+        if (this->state.compare_exchange_strong(expected, sleeping, ::std::memory_order_acq_rel)) {
+            return true;
+        }
+        this->state.store(awake, ::std::memory_order_release);
+        return false;
+    }
+    /*!
+     * \brief Mark the consumer as awake after blocking in a system call of its own.
+     */
+    auto woken() noexcept -> void { this->state.store(awake, ::std::memory_order_release); }
+    /*!
+     * \brief Block until notified; requires a preceding successful `prepare_wait()`.
+     */
+    auto wait() noexcept -> void {
+        ::pollfd entry{this->fd, POLLIN, 0};
+        while (::poll(&entry, 1u, -1) < 0 && errno == EINTR) {
+        }
+        // Reset the eventfd: a stale count would keep poll() from blocking.
+        ::std::uint64_t       count{};
+        [[maybe_unused]] auto rc{::read(this->fd, &count, sizeof(count))};
+        this->woken();
+    }
+
+  private:
+    static constexpr int awake{0};
+    static constexpr int sleeping{1};
+    static constexpr int notified{2};
+
+    int                fd;
+    ::std::atomic<int> state{awake};
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+// include/beman/task/detail/exceptions.hpp                           -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EXCEPTIONS
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EXCEPTIONS
+
+#include <atomic>
+#include <exception>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// The library supports builds without exception support, e.g., using
+// -fno-exceptions. In such builds BEMAN_TASK_HAS_EXCEPTIONS isn't defined:
+// - `BEMAN_TASK_TRY { ... } BEMAN_TASK_CATCH_ALL { ... }` only executes
+//   the first block.
+// - `throw_exception(e)`, `rethrow_exception(ptr)`, and `rethrow()` call
+//   `unhandled_failure()` instead of throwing.
+// - The default error types of a task don't contain `std::exception_ptr`
+//   and errors of awaited tasks are forwarded instead of thrown.
+
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define BEMAN_TASK_HAS_EXCEPTIONS 1
+#define BEMAN_TASK_TRY try
+#define BEMAN_TASK_CATCH_ALL catch (...)
+#else
+#define BEMAN_TASK_TRY if (true)
+#define BEMAN_TASK_CATCH_ALL else
+#endif
+
+namespace beman::task::detail {
+/*!
+ * \brief Type of functions called on failures which can't be reported
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ */
+using failure_handler = void (*)() noexcept;
+
+/*!
+ * \brief Storage of the currently registered `failure_handler`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+inline auto failure_handler_storage() noexcept -> ::std::atomic<failure_handler>& {
+    static ::std::atomic<failure_handler> handler{nullptr};
+    return handler;
+}
+
+/*!
+ * \brief Register a function called on failures which can't be reported
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * The handler is called, e.g., when an exception escapes a coroutine
+ * whose error types don't include `std::exception_ptr` or, in builds
+ * without exceptions, when an error would need to be thrown. When the
+ * handler returns, `std::terminate()` is called. The previously
+ * registered handler is returned.
+ */
+inline auto set_failure_handler(failure_handler handler) noexcept -> failure_handler {
+    return ::beman::task::detail::failure_handler_storage().exchange(handler);
+}
+
+/*!
+ * \brief Report a failure which can't be reported otherwise
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+[[noreturn]] inline auto unhandled_failure() noexcept -> void {
+    if (failure_handler handler{::beman::task::detail::failure_handler_storage().load()}) {
+        handler();
+    }
+    ::std::terminate();
+}
+
+/*!
+ * \brief Throw `error` or, without exceptions, report an unhandled failure
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+template <typename E>
+[[noreturn]] auto throw_exception([[maybe_unused]] E&& error) -> void {
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+    throw ::std::forward<E>(error);
+#else
+    ::beman::task::detail::unhandled_failure();
+#endif
+}
+
+/*!
+ * \brief Rethrow `ptr` or, without exceptions, report an unhandled failure
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+[[noreturn]] inline auto rethrow_exception([[maybe_unused]] ::std::exception_ptr ptr) -> void {
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+    ::std::rethrow_exception(::std::move(ptr));
+#else
+    ::beman::task::detail::unhandled_failure();
+#endif
+}
+
+/*!
+ * \brief Rethrow the current exception; only used in `BEMAN_TASK_CATCH_ALL` blocks
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+[[noreturn]] inline auto rethrow() -> void {
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+    throw;
+#else
+    ::beman::task::detail::unhandled_failure();
+#endif
+}
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,85 @@
+// include/beman/task/detail/extern_templates.hpp                     -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EXTERN_TEMPLATES
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_EXTERN_TEMPLATES
+
+#include <beman/task/detail/awaiter.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/inline_scheduler.hpp>
+#include <beman/task/detail/promise_type.hpp>
+#include <beman/task/detail/state_base.hpp>
+#include <beman/task/detail/task.hpp>
+#include <beman/task/detail/task_scheduler.hpp>
+#include <beman/execution/execution.hpp>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// The commonly used specializations, i.e., task<void> and task<int> with the
+// default environment and the task_scheduler wrapping the inline_scheduler
+// or the run_loop's scheduler, are explicitly instantiated in the library:
+// translation units using them don't need to instantiate them, emitting
+// their vtables, again. src/beman/task/task.cpp defines
+// BEMAN_TASK_EXTERN_TEMPLATE as empty to turn the declarations below into
+// the explicit instantiation definitions. Defining
+// BEMAN_TASK_NO_EXTERN_TEMPLATES suppresses the declarations, e.g., to use
+// the headers without the library; the build does so unless the CMake
+// option BEMAN_TASK_EXTERN_TEMPLATES is ON. The explicit instantiations
+// define every member of these classes: the objects using them get smaller
+// but a program using any of them links all of them, i.e., small programs
+// get larger. The library is compiled with exceptions:
+// translation units built without exception support, i.e., where
+// BEMAN_TASK_HAS_EXCEPTIONS isn't defined, compile the templates differently
+// and always instantiate their own copies rather than mixing definitions.
+
+#if !defined(BEMAN_TASK_NO_EXTERN_TEMPLATES) && defined(BEMAN_TASK_HAS_EXCEPTIONS)
+#ifndef BEMAN_TASK_EXTERN_TEMPLATE
+#define BEMAN_TASK_EXTERN_TEMPLATE extern
+#endif
+
+namespace beman::task::detail {
+BEMAN_TASK_EXTERN_TEMPLATE template class task<void, default_environment>;
+BEMAN_TASK_EXTERN_TEMPLATE template class task<int, default_environment>;
+BEMAN_TASK_EXTERN_TEMPLATE template class promise_type<task<void, default_environment>, void, default_environment>;
+BEMAN_TASK_EXTERN_TEMPLATE template class promise_type<task<int, default_environment>, int, default_environment>;
+BEMAN_TASK_EXTERN_TEMPLATE template class state_base<void, default_environment>;
+BEMAN_TASK_EXTERN_TEMPLATE template class state_base<int, default_environment>;
+
+BEMAN_TASK_EXTERN_TEMPLATE template class awaiter<
+    void,
+    default_environment,
+    promise_type<task<void, default_environment>, void, default_environment>,
+    promise_type<task<void, default_environment>, void, default_environment>>;
+BEMAN_TASK_EXTERN_TEMPLATE template class awaiter<
+    int,
+    default_environment,
+    promise_type<task<int, default_environment>, int, default_environment>,
+    promise_type<task<void, default_environment>, void, default_environment>>;
+BEMAN_TASK_EXTERN_TEMPLATE template class awaiter<
+    void,
+    default_environment,
+    promise_type<task<void, default_environment>, void, default_environment>,
+    promise_type<task<int, default_environment>, int, default_environment>>;
+BEMAN_TASK_EXTERN_TEMPLATE template class awaiter<
+    int,
+    default_environment,
+    promise_type<task<int, default_environment>, int, default_environment>,
+    promise_type<task<int, default_environment>, int, default_environment>>;
+
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::concrete<inline_scheduler>;
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::sender::concrete<inline_scheduler&>;
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::inner_state::concrete<
+    decltype(::beman::execution::schedule(::std::declval<inline_scheduler&>()))>;
+
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::concrete<
+    decltype(::std::declval<::beman::execution::run_loop&>().get_scheduler())>;
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::sender::concrete<
+    decltype(::std::declval<::beman::execution::run_loop&>().get_scheduler())&>;
+BEMAN_TASK_EXTERN_TEMPLATE template struct task_scheduler::inner_state::concrete<decltype(::beman::execution::schedule(
+    ::std::declval<decltype(::std::declval<::beman::execution::run_loop&>().get_scheduler())&>()))>;
+} // namespace beman::task::detail
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,103 @@
+// include/beman/task/detail/forward_error_codes.hpp                  -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FORWARD_ERROR_CODES
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FORWARD_ERROR_CODES
+
+#include <beman/task/detail/error_code.hpp>
+#include <beman/task/detail/meta.hpp>
+#include <beman/execution/execution.hpp>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Sender adaptor completing the awaiting coroutine with error codes
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * The sender `forward_error_codes(sndr, promise)` is used by a `task`
+ * whose context reports error codes when `co_await`ing `sndr`: errors of
+ * `sndr` which can be represented as `std::error_code` are passed to
+ * `promise.forward_error(ec)` and the coroutine returned is resumed,
+ * i.e., the awaiting coroutine completes with the error code. Like a
+ * stopped completion of an awaited sender the error doesn't reach the
+ * awaitable. All other completions are passed on unchanged.
+ */
+struct forward_error_codes_t {
+    template <typename S>
+    static constexpr auto is_error_code_error(S*) -> bool {
+        return false;
+    }
+    template <typename E>
+    static constexpr auto is_error_code_error(::beman::execution::set_error_t (*)(E)) -> bool {
+        return ::beman::task::detail::maps_to_error_code<E>;
+    }
+
+    template <typename>
+    struct without_error_codes;
+    template <typename... S>
+    struct without_error_codes<::beman::execution::completion_signatures<S...>> {
+        using type = ::beman::task::detail::meta::concat_t<
+            ::beman::execution::completion_signatures<>,
+            ::std::conditional_t<forward_error_codes_t::is_error_code_error(static_cast<S*>(nullptr)),
+                                 ::beman::execution::completion_signatures<>,
+                                 ::beman::execution::completion_signatures<S>>...>;
+    };
+
+    template <typename Receiver, typename Promise>
+    struct receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        ::std::remove_cvref_t<Receiver> rcvr;
+        Promise*                        promise;
+
+        template <typename... A>
+        auto set_value(A&&... a) && noexcept -> void {
+            ::beman::execution::set_value(::std::move(this->rcvr), ::std::forward<A>(a)...);
+        }
+        template <typename E>
+        auto set_error(E&& e) && noexcept -> void {
+            if constexpr (::beman::task::detail::maps_to_error_code<::std::remove_cvref_t<E>>) {
+                this->promise->forward_error(::beman::task::detail::to_error_code(e)).resume();
+            } else {
+                ::beman::execution::set_error(::std::move(this->rcvr), ::std::forward<E>(e));
+            }
+        }
+        auto set_stopped() && noexcept -> void { ::beman::execution::set_stopped(::std::move(this->rcvr)); }
+        auto get_env() const noexcept -> decltype(auto) { return ::beman::execution::get_env(this->rcvr); }
+    };
+
+    template <::beman::execution::sender Upstream, typename Promise>
+    struct sender {
+        using sender_concept = ::beman::execution::sender_t;
+        Upstream upstream;
+        Promise* promise;
+
+        template <typename Env>
+        auto get_completion_signatures(Env&&) const {
+            return typename without_error_codes<
+                ::beman::execution::completion_signatures_of_t<Upstream, ::std::remove_cvref_t<Env>>>::type();
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& rcvr) && {
+            return ::beman::execution::connect(::std::move(this->upstream),
+                                               receiver<Receiver, Promise>{::std::forward<Receiver>(rcvr),
+                                                                           this->promise});
+        }
+    };
+
+    template <::beman::execution::sender Upstream, typename Promise>
+    auto operator()(Upstream&& upstream, Promise& promise) const {
+        return sender<::std::remove_cvref_t<Upstream>, Promise>{::std::forward<Upstream>(upstream), &promise};
+    }
+};
+
+inline constexpr forward_error_codes_t forward_error_codes{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
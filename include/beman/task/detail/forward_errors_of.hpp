@@ -0,0 +1,48 @@
+// include/beman/task/detail/forward_errors_of.hpp                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FORWARD_ERRORS_OF
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FORWARD_ERRORS_OF
+
+#include <beman/task/detail/exceptions.hpp>
+#include <concepts>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Utility to determine whether a context forwards errors of awaited tasks
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A context can define a `static constexpr bool forward_errors`. If it is
+ * `true`, a coroutine using this context which `co_await`s a task
+ * completing with an error other than `std::exception_ptr` doesn't get
+ * the error thrown: if the error type is one of the coroutine's own
+ * `error_types`, the coroutine completes directly with this error, as if
+ * it had used `co_yield with_error(error)`. Errors the coroutine can't
+ * complete with are still thrown. The default is `false` unless the
+ * build doesn't support exceptions.
+ */
+template <typename>
+struct forward_errors_of {
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+    static constexpr bool value{false};
+#else
+    static constexpr bool value{true};
+#endif
+};
+template <typename Context>
+    requires requires {
+        { Context::forward_errors } -> std::convertible_to<bool>;
+    }
+struct forward_errors_of<Context> {
+    static constexpr bool value{Context::forward_errors};
+};
+template <typename Context>
+inline constexpr bool forward_errors_of_v{forward_errors_of<Context>::value};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
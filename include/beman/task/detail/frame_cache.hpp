@@ -0,0 +1,107 @@
+// include/beman/task/detail/frame_cache.hpp                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FRAME_CACHE
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FRAME_CACHE
+
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief One-slot cache for the memory of coroutine frames
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A coroutine recycling frames embeds a `frame_cache` into its promise
+ * and makes it the thread's current cache whenever it is resumed. The
+ * current cache is reset whenever the coroutine suspends, i.e., a
+ * `frame_cache` is only current while its owner is running on the
+ * thread. When the frame of a coroutine using `allocator_support` with
+ * `RecycleFrames` enabled is released while a cache is current and the
+ * cache is empty, the memory is kept in the cache instead of being
+ * deallocated. The next such frame of the same size using an equal
+ * allocator takes the memory from the cache.
+ * Thus, a coroutine repeatedly `co_await`ing tasks of the same kind, e.g.,
+ * in a loop, allocates the frame for these tasks only once.
+ *
+ * The memory is kept together with the function releasing it: the
+ * allocator sees the first allocation and the final deallocation when
+ * the cache is destroyed.
+ */
+class frame_cache {
+  public:
+    using release_t = void (*)(void*, ::std::size_t) noexcept;
+
+    frame_cache() = default;
+    frame_cache(const frame_cache&)            = delete;
+    frame_cache& operator=(const frame_cache&) = delete;
+    ~frame_cache() { this->clear(); }
+
+    static auto current() noexcept -> frame_cache* { return frame_cache::current_cache(); }
+    static auto enter(frame_cache* cache) noexcept -> void { frame_cache::current_cache() = cache; }
+    static auto leave() noexcept -> void { frame_cache::current_cache() = nullptr; }
+
+    auto holds(::std::size_t size, release_t release) const noexcept -> bool {
+        return this->memory != nullptr && this->size == size && this->release == release;
+    }
+    auto peek() const noexcept -> void* { return this->memory; }
+    auto take() noexcept -> void* { return ::std::exchange(this->memory, nullptr); }
+    auto put(void* mem, ::std::size_t sz, release_t rel) noexcept -> bool {
+        if (this->memory != nullptr) {
+            return false;
+        }
+        this->memory  = mem;
+        this->size    = sz;
+        this->release = rel;
+        return true;
+    }
+    auto clear() noexcept -> void {
+        if (void* mem{this->take()}) {
+            this->release(mem, this->size);
+        }
+    }
+
+  private:
+    static auto current_cache() noexcept -> frame_cache*& {
+        thread_local frame_cache* cache{nullptr};
+        return cache;
+    }
+
+    void*         memory{};
+    ::std::size_t size{};
+    release_t     release{};
+};
+
+/*!
+ * \brief Awaitable wrapper maintaining the current `frame_cache`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * The current cache is reset before the wrapped awaitable suspends the
+ * coroutine and set to `cache` when the coroutine is resumed.
+ */
+template <typename Awaitable>
+struct frame_cache_awaitable {
+    ::beman::task::detail::frame_cache* cache;
+    Awaitable                           awaitable;
+
+    auto await_ready() -> bool { return this->awaitable.await_ready(); }
+    template <typename Promise>
+    auto await_suspend(::std::coroutine_handle<Promise> handle) -> decltype(auto) {
+        ::beman::task::detail::frame_cache::leave();
+        return this->awaitable.await_suspend(handle);
+    }
+    auto await_resume() -> decltype(auto) {
+        ::beman::task::detail::frame_cache::enter(this->cache);
+        return this->awaitable.await_resume();
+    }
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,156 @@
+// include/beman/task/detail/frame_registry.hpp                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FRAME_REGISTRY
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_FRAME_REGISTRY
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Defining BEMAN_TASK_FRAME_SIZE_REGISTRY, e.g., using the CMake option of
+// the same name, makes allocator_support::operator new record the size of
+// each coroutine frame it allocates in the frame_registry. The promise
+// identifies the frame with the location of the coroutine. The same
+// setting needs to be used for all translation units of a program.
+
+namespace beman::task::detail {
+/*!
+ * \brief Frame sizes recorded for one coroutine
+ * \headerfile beman/task/frame_registry.hpp <beman/task/frame_registry.hpp>
+ *
+ * The `location` is the one of the coroutine whose frames were allocated.
+ * Frames which were released before their promise identified them have a
+ * default constructed `location`, i.e., its `line()` is `0`.
+ */
+struct frame_size_record {
+    ::std::source_location location;
+    ::std::size_t          size;
+    ::std::size_t          count;
+};
+
+/*!
+ * \brief Registry of the sizes of allocated coroutine frames
+ * \headerfile beman/task/frame_registry.hpp <beman/task/frame_registry.hpp>
+ *
+ * The registry counts the allocations per pair of coroutine and frame
+ * size. It is only filled when the library is built with
+ * `BEMAN_TASK_FRAME_SIZE_REGISTRY` defined: `allocator_support` reports
+ * each frame it allocates and releases using `allocated()` and
+ * `deallocated()`. When the promise's `get_return_object()` is called it
+ * passes the `std::source_location` of the coroutine to `identify()`
+ * which records the frame. `dump(file)` writes one line
+ * `size<TAB>count<TAB>file:line<TAB>function` per entry, the format read
+ * by the `frame_sizes` tool which prints a histogram of the frame sizes.
+ * If the environment variable `BEMAN_TASK_FRAME_SIZES` names a file when
+ * the program exits, the registry is appended to this file.
+ *
+ * Usage:
+ *
+ *     BEMAN_TASK_FRAME_SIZES=frames.txt ./application
+ *     frame_sizes frames.txt
+ */
+class frame_registry {
+  public:
+    static auto instance() -> frame_registry& {
+        static frame_registry registry;
+        return registry;
+    }
+
+    frame_registry() = default;
+    frame_registry(const frame_registry&)            = delete;
+    frame_registry& operator=(const frame_registry&) = delete;
+    ~frame_registry() {
+        if (const char* name{::std::getenv("BEMAN_TASK_FRAME_SIZES")}) {
+            if (::std::FILE* file{::std::fopen(name, "a")}) {
+                this->dump(file);
+                ::std::fclose(file);
+            }
+        }
+    }
+
+    auto allocated(const void* frame, ::std::size_t size) -> void {
+        ::std::lock_guard guard(this->mutex);
+        this->pending[frame] = size;
+    }
+    auto identify(const void* frame, const ::std::source_location& location) -> void {
+        ::std::lock_guard guard(this->mutex);
+        if (auto it{this->pending.find(frame)}; it != this->pending.end()) {
+            ++this->counts[key{location, it->second}];
+            this->pending.erase(it);
+        }
+    }
+    auto deallocated(const void* frame) -> void {
+        ::std::lock_guard guard(this->mutex);
+        if (auto it{this->pending.find(frame)}; it != this->pending.end()) {
+            ++this->counts[key{::std::source_location(), it->second}];
+            this->pending.erase(it);
+        }
+    }
+    auto record(const ::std::source_location& location, ::std::size_t size) -> void {
+        ::std::lock_guard guard(this->mutex);
+        ++this->counts[key{location, size}];
+    }
+    auto records() const -> ::std::vector<::beman::task::detail::frame_size_record> {
+        ::std::lock_guard                                       guard(this->mutex);
+        ::std::vector<::beman::task::detail::frame_size_record> rc;
+        rc.reserve(this->counts.size());
+        for (const auto& [k, count] : this->counts) {
+            rc.push_back(::beman::task::detail::frame_size_record{k.location, k.size, count});
+        }
+        return rc;
+    }
+    auto clear() -> void {
+        ::std::lock_guard guard(this->mutex);
+        this->counts.clear();
+        this->pending.clear();
+    }
+    auto dump(::std::FILE* file) const -> void {
+        for (const auto& e : this->records()) {
+            ::std::fprintf(file,
+                           "%zu\t%zu\t%s:%lu\t%s\n",
+                           e.size,
+                           e.count,
+                           e.location.line() == 0u ? "(unidentified)" : e.location.file_name(),
+                           static_cast<unsigned long>(e.location.line()),
+                           e.location.function_name());
+        }
+    }
+
+  private:
+    struct key {
+        ::std::source_location location;
+        ::std::size_t          size;
+
+        auto operator==(const key& other) const noexcept -> bool {
+            return this->size == other.size && this->location.line() == other.location.line() &&
+                   this->location.column() == other.location.column() &&
+                   ::std::string_view(this->location.file_name()) == other.location.file_name() &&
+                   ::std::string_view(this->location.function_name()) == other.location.function_name();
+        }
+    };
+    struct hash {
+        auto operator()(const key& k) const noexcept -> ::std::size_t {
+            ::std::size_t rc{::std::hash<::std::string_view>{}(k.location.function_name())};
+            rc ^= ::std::hash<::std::uint_least32_t>{}(k.location.line()) + 0x9e3779b9u + (rc << 6) + (rc >> 2);
+            return rc ^ (::std::hash<::std::size_t>{}(k.size) + 0x9e3779b9u + (rc << 6) + (rc >> 2));
+        }
+    };
+
+    mutable ::std::mutex                                           mutex;
+    ::std::unordered_map<const void*, ::std::size_t>               pending;
+    ::std::unordered_map<key, ::std::size_t, frame_registry::hash> counts;
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,80 @@
+// include/beman/task/detail/get_deadline.hpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_GET_DEADLINE
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_GET_DEADLINE
+
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <concepts>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Query for the point in time by which work should be completed
+ * \headerfile beman/task/edf_scheduler.hpp <beman/task/edf_scheduler.hpp>
+ *
+ * The query `get_deadline(env)` yields a `std::chrono::steady_clock::time_point`.
+ * It is a forwarding query: a `task` whose context answers the query
+ * exposes the deadline to all senders it awaits, e.g., to the scheduler
+ * used by `affine_on` (also through a `task_scheduler`), and via
+ * `co_await read_env(get_deadline)`.
+ */
+struct get_deadline_t {
+    template <typename Env>
+        requires requires(const Env& env, const get_deadline_t& q) { env.query(q); }
+    auto operator()(const Env& env) const noexcept -> ::std::chrono::steady_clock::time_point {
+        return env.query(*this);
+    }
+    constexpr auto query(const ::beman::execution::forwarding_query_t&) const noexcept -> bool { return true; }
+};
+
+inline constexpr get_deadline_t get_deadline{};
+
+/*!
+ * \brief Get the deadline of an environment or `time_point::max()` without one
+ * \headerfile beman/task/edf_scheduler.hpp <beman/task/edf_scheduler.hpp>
+ * \internal
+ */
+template <typename Env>
+auto deadline_of(const Env& env) noexcept -> ::std::chrono::steady_clock::time_point {
+    if constexpr (requires { ::beman::task::detail::get_deadline(env); }) {
+        return ::beman::task::detail::get_deadline(env);
+    } else {
+        return ::std::chrono::steady_clock::time_point::max();
+    }
+}
+
+/*!
+ * \brief Task context carrying a deadline
+ * \headerfile beman/task/edf_scheduler.hpp <beman/task/edf_scheduler.hpp>
+ *
+ * A `task<T, deadline_environment>` picks up the deadline from the
+ * environment it is started in (the receiver's environment or, for a
+ * `co_await`ed task, the environment of the awaiting coroutine) and
+ * answers `get_deadline` queries with it. Without a deadline in the
+ * environment the deadline is `time_point::max()`. The type can be used
+ * as a base of other contexts.
+ */
+struct deadline_environment {
+    using clock_type = ::std::chrono::steady_clock;
+
+    clock_type::time_point deadline{clock_type::time_point::max()};
+
+    deadline_environment() = default;
+    explicit deadline_environment(clock_type::time_point d) : deadline(d) {}
+    template <typename Env>
+        requires(not ::std::derived_from<::std::remove_cvref_t<Env>, deadline_environment>)
+    explicit deadline_environment(const Env& env) : deadline(::beman::task::detail::deadline_of(env)) {}
+
+    auto query(const ::beman::task::detail::get_deadline_t&) const noexcept -> clock_type::time_point {
+        return this->deadline;
+    }
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,57 @@
+// include/beman/task/detail/get_priority.hpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_GET_PRIORITY
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_GET_PRIORITY
+
+#include <beman/execution/execution.hpp>
+#include <cstddef>
+#include <optional>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Query for the priority lane to be used for scheduled work
+ * \headerfile beman/task/priority_scheduler.hpp <beman/task/priority_scheduler.hpp>
+ *
+ * The query `get_priority(env)` yields the lane (`0` being the most
+ * urgent) work should be scheduled on. It is a forwarding query, i.e., a
+ * `task` whose context answers the query exposes it to all senders it
+ * awaits. In particular, the continuation scheduled by `affine_on` when
+ * an awaited sender completes uses the task's lane, also when the task's
+ * scheduler is a `task_scheduler`.
+ *
+ * An environment which only knows at run time whether it has a priority,
+ * e.g., the one `task_scheduler` passes to the scheduler it wraps, answers
+ * the query with a `std::optional<std::size_t>`.
+ */
+struct get_priority_t {
+    template <typename Env>
+        requires requires(const Env& env, const get_priority_t& q) { env.query(q); }
+    auto operator()(const Env& env) const noexcept {
+        return env.query(*this);
+    }
+    constexpr auto query(const ::beman::execution::forwarding_query_t&) const noexcept -> bool { return true; }
+};
+
+inline constexpr get_priority_t get_priority{};
+
+/*!
+ * \brief Get the priority lane requested by an environment, if any
+ * \headerfile beman/task/priority_scheduler.hpp <beman/task/priority_scheduler.hpp>
+ * \internal
+ */
+template <typename Env>
+auto priority_of(const Env& env) noexcept -> ::std::optional<::std::size_t> {
+    if constexpr (requires { ::beman::task::detail::get_priority(env); }) {
+        return ::beman::task::detail::get_priority(env);
+    } else {
+        return ::std::nullopt;
+    }
+}
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
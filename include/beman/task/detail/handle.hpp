@@ -15,22 +15,25 @@ namespace beman::task::detail {
 template <typename P>
 class handle {
   private:
-    using deleter = decltype([](auto p) {
-        if (p) {
-            std::coroutine_handle<P>::from_promise(*p).destroy();
+    struct deleter {
+        auto operator()(P* p) const noexcept -> void {
+            if (p) {
+                std::coroutine_handle<P>::from_promise(*p).destroy();
+            }
         }
-    });
+    };
     std::unique_ptr<P, deleter> h;
 
   public:
-    explicit handle(P* p) : h(p) {}
+    explicit handle(P* p) noexcept : h(p) {}
     auto reset() -> void { this->h.reset(); }
     template <typename... A>
     auto start(A&&... a) noexcept -> auto {
         return this->h->start(::std::forward<A>(a)...);
     }
     auto release() -> ::std::coroutine_handle<P> {
-        return ::std::coroutine_handle<P>::from_promise(*this->h.release());
+        P* p{this->h.release()};
+        return p ? ::std::coroutine_handle<P>::from_promise(*p) : ::std::coroutine_handle<P>();
     }
 };
 
@@ -4,8 +4,12 @@
 #ifndef INCLUDED_BEMAN_TASK_DETAIL_INTO_OPTIONAL
 #define INCLUDED_BEMAN_TASK_DETAIL_INTO_OPTIONAL
 
+#include <expected>
 #include <optional>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <beman/execution/execution.hpp>
 
 // ----------------------------------------------------------------------------
@@ -90,6 +94,119 @@ inline constexpr struct into_optional_t : beman::execution::sender_adaptor_closu
         return {std::forward<Upstream>(upstream)};
     }
 } into_optional{};
+
+/*!
+ * \brief Sender adaptor turning errors into a value of type `std::expected`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * The sender `as_expected(sndr)` completes with `set_value(exp)` where
+ * `exp` is a `std::expected<T, E>`: `T` is the value type of `sndr`
+ * (`void` if `sndr` completes with `set_value()` or never completes
+ * with a value and a `std::tuple` of the arguments if there are
+ * multiple), `E` is the error type of `sndr` or a `std::variant` of the
+ * error types if there are multiple.
+ * Stopped completions are passed on unchanged. Neither `exception_ptr`s
+ * are created nor errors thrown: `co_await as_expected(sndr)` can
+ * inspect an error code of a failing operation on the hot path. The
+ * value and error types should be nothrow move constructible: an
+ * exception while constructing the result terminates the program.
+ * Senders with multiple value completion signatures are rejected at
+ * compile time.
+ *
+ * Usage:
+ *
+ *     std::expected<std::size_t, std::error_code> n{co_await as_expected(read(socket, buffer))};
+ *     if (not n) { ... }
+ */
+inline constexpr struct as_expected_t : beman::execution::sender_adaptor_closure<as_expected_t> {
+    template <typename...>
+    struct type_list {};
+
+    static auto value_type_for(type_list<>) -> std::type_identity<void>;
+    template <typename T>
+    static auto value_type_for(type_list<T>) -> std::type_identity<T>;
+    template <typename T0, typename T1, typename... T>
+    static auto value_type_for(type_list<T0, T1, T...>) -> std::type_identity<std::tuple<T0, T1, T...>>;
+
+    static auto error_type_for(type_list<>) -> std::type_identity<std::monostate>;
+    template <typename E>
+    static auto error_type_for(type_list<E>) -> std::type_identity<E>;
+    template <typename E0, typename E1, typename... E>
+    static auto error_type_for(type_list<E0, E1, E...>) -> std::type_identity<std::variant<E0, E1, E...>>;
+
+    template <typename Values, typename Errors>
+    struct expected_for {
+        static_assert(sizeof(Values) == 0u,
+                      "as_expected(sndr) requires sndr to have at most one set_value completion signature");
+    };
+    template <typename Errors>
+    struct expected_for<type_list<>, Errors> {
+        using type = std::expected<void, typename decltype(as_expected_t::error_type_for(Errors{}))::type>;
+    };
+    template <typename Values, typename Errors>
+    struct expected_for<type_list<Values>, Errors> {
+        using type = std::expected<typename decltype(as_expected_t::value_type_for(Values{}))::type,
+                                   typename decltype(as_expected_t::error_type_for(Errors{}))::type>;
+    };
+
+    template <typename Upstream, typename Env>
+    using expected_t = typename expected_for<
+        ::beman::execution::value_types_of_t<Upstream, std::remove_cvref_t<Env>, type_list, type_list>,
+        ::beman::execution::error_types_of_t<Upstream, std::remove_cvref_t<Env>, type_list>>::type;
+
+    template <typename Receiver, typename Expected>
+    struct receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        std::remove_cvref_t<Receiver> rcvr;
+
+        template <typename... A>
+        auto set_value(A&&... a) && noexcept -> void {
+            ::beman::execution::set_value(std::move(this->rcvr), Expected(std::in_place, std::forward<A>(a)...));
+        }
+        template <typename E>
+        auto set_error(E&& e) && noexcept -> void {
+            using error_type = typename Expected::error_type;
+            if constexpr (std::same_as<error_type, std::remove_cvref_t<E>>)
+                ::beman::execution::set_value(std::move(this->rcvr), Expected(std::unexpect, std::forward<E>(e)));
+            else
+                ::beman::execution::set_value(
+                    std::move(this->rcvr),
+                    Expected(std::unexpect, std::in_place_type<std::remove_cvref_t<E>>, std::forward<E>(e)));
+        }
+        auto set_stopped() && noexcept -> void { ::beman::execution::set_stopped(std::move(this->rcvr)); }
+        auto get_env() const noexcept -> decltype(auto) { return ::beman::execution::get_env(this->rcvr); }
+    };
+
+    template <::beman::execution::sender Upstream>
+    struct sender {
+        using upstream_t     = std::remove_cvref_t<Upstream>;
+        using sender_concept = ::beman::execution::sender_t;
+        upstream_t upstream;
+
+        template <typename Env>
+        auto get_completion_signatures(Env&&) const {
+            if constexpr (::beman::execution::sends_stopped<Upstream, std::remove_cvref_t<Env>>)
+                return ::beman::execution::completion_signatures<
+                    ::beman::execution::set_value_t(expected_t<Upstream, Env>),
+                    ::beman::execution::set_stopped_t()>();
+            else
+                return ::beman::execution::completion_signatures<
+                    ::beman::execution::set_value_t(expected_t<Upstream, Env>)>();
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& rcvr) && {
+            using expected_type = expected_t<Upstream, decltype(::beman::execution::get_env(rcvr))>;
+            return ::beman::execution::connect(std::move(this->upstream),
+                                               receiver<Receiver, expected_type>{std::forward<Receiver>(rcvr)});
+        }
+    };
+
+    template <typename Upstream>
+    sender<Upstream> operator()(Upstream&& upstream) const {
+        return {std::forward<Upstream>(upstream)};
+    }
+} as_expected{};
 } // namespace beman::task::detail
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,709 @@
+// include/beman/task/detail/io_uring_context.hpp                     -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_IO_URING_CONTEXT
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_IO_URING_CONTEXT
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define BEMAN_TASK_HAS_IO_URING 1
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Index of a file registered with an `io_uring_context`
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ */
+struct registered_file {
+    unsigned index;
+};
+
+/*!
+ * \brief Buffer registered with an `io_uring_context`
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ *
+ * The `index` refers to the position of the buffer passed to
+ * `register_buffers()`; `data` may be any part of that buffer.
+ */
+struct registered_buffer {
+    unsigned                 index;
+    ::std::span<::std::byte> data;
+};
+
+/*!
+ * \brief Execution context performing file I/O using Linux io_uring
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ *
+ * An `io_uring_context` owns an io_uring instance and a thread submitting
+ * the requests and completing the operations. Its scheduler can be used
+ * as the scheduler of a `task`: work scheduled on it is resumed on the
+ * context's thread. The senders `async_read`, `async_write`, `async_fsync`
+ * and `async_openat` perform the respective operation asynchronously.
+ *
+ * Requests from any thread are queued and submitted in batches: all
+ * requests queued while the context's thread is busy are submitted with
+ * one system call. With `sqpoll` a kernel thread polls the submission
+ * queue, i.e., submissions normally don't need any system call.
+ * Buffers and files can be registered to avoid mapping them for every
+ * request. Stop requests on the receiver's stop token are turned into
+ * `IORING_OP_ASYNC_CANCEL` requests; cancelled operations complete with
+ * `set_stopped()`. Failures complete with `set_error(std::error_code)`.
+ *
+ * This component is only available when `<linux/io_uring.h>` is present.
+ *
+ * Usage:
+ *
+ *     io_uring_context io;
+ *     auto n{co_await async_read(io.get_scheduler(), fd, buffer, offset)};
+ */
+class io_uring_context {
+  public:
+    class scheduler;
+    template <typename Op>
+    class sender;
+
+    struct options {
+        unsigned entries{256u};
+        bool     sqpoll{false};
+        unsigned sqpoll_idle_ms{100u};
+    };
+
+    io_uring_context() : io_uring_context(options{}) {}
+    explicit io_uring_context(options opts) {
+        ::io_uring_params params{};
+        if (opts.sqpoll) {
+            params.flags |= IORING_SETUP_SQPOLL;
+            params.sq_thread_idle = opts.sqpoll_idle_ms;
+        }
+        this->ring = int(::syscall(__NR_io_uring_setup, opts.entries, &params));
+        if (this->ring < 0) {
+            ::beman::task::detail::throw_exception(
+                ::std::system_error(errno, ::std::system_category(), "io_uring_setup"));
+        }
+        this->sqpoll = opts.sqpoll;
+        BEMAN_TASK_TRY {
+            this->map(params);
+            this->wakeup.fd = ::eventfd(0u, EFD_CLOEXEC);
+            if (this->wakeup.fd < 0) {
+                ::beman::task::detail::throw_exception(
+                    ::std::system_error(errno, ::std::system_category(), "eventfd"));
+            }
+        }
+        BEMAN_TASK_CATCH_ALL {
+            this->unmap();
+            ::beman::task::detail::rethrow();
+        }
+        this->thread = ::std::thread([this] { this->run(); });
+    }
+    io_uring_context(const io_uring_context&)            = delete;
+    io_uring_context& operator=(const io_uring_context&) = delete;
+    ~io_uring_context() {
+        {
+            ::std::lock_guard guard(this->mutex);
+            this->done = true;
+        }
+        this->notify();
+        this->thread.join();
+        this->unmap();
+    }
+
+    auto get_scheduler() -> scheduler;
+
+    /*!
+     * \brief Register buffers to be used with `registered_buffer`.
+     */
+    auto register_buffers(::std::span<const ::iovec> buffers) -> void {
+        this->do_register(IORING_REGISTER_BUFFERS, buffers.data(), unsigned(buffers.size()), "register buffers");
+    }
+    /*!
+     * \brief Register files to be used with `registered_file`.
+     */
+    auto register_files(::std::span<const int> files) -> void {
+        this->do_register(IORING_REGISTER_FILES, files.data(), unsigned(files.size()), "register files");
+    }
+
+  private:
+    template <typename Receiver, typename Op>
+    struct state;
+
+    // A request queued for submission. Each node submits exactly one SQE
+    // whose user_data points to the node and gets its CQE's result.
+    struct node {
+        node*        next{};
+        virtual auto prepare(::io_uring_sqe& sqe) noexcept -> void = 0;
+        virtual auto complete(int result) noexcept -> void         = 0;
+
+      protected:
+        ~node() = default;
+    };
+    // Keeps a read of the eventfd pending to wake the thread up for new requests.
+    struct wakeup_node : node {
+        int             fd{-1};
+        ::std::uint64_t value{};
+        bool            armed{false};
+
+        auto prepare(::io_uring_sqe& sqe) noexcept -> void override {
+            sqe.opcode  = IORING_OP_READ;
+            sqe.fd      = this->fd;
+            sqe.addr    = reinterpret_cast<::std::uintptr_t>(&this->value);
+            sqe.len     = sizeof(this->value);
+            this->armed = true;
+        }
+        auto complete(int) noexcept -> void override { this->armed = false; }
+    };
+
+    auto map(const ::io_uring_params& params) -> void {
+        this->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        this->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            this->sq_size = this->cq_size = ::std::max(this->sq_size, this->cq_size);
+        }
+        this->sq_ring = this->mmap(this->sq_size, IORING_OFF_SQ_RING);
+        this->cq_ring = params.features & IORING_FEAT_SINGLE_MMAP ? this->sq_ring
+                                                                  : this->mmap(this->cq_size, IORING_OFF_CQ_RING);
+        this->sqes = static_cast<::io_uring_sqe*>(
+            this->mmap(params.sq_entries * sizeof(::io_uring_sqe), IORING_OFF_SQES));
+
+        auto at{[](void* base, ::std::uint32_t offset) {
+            return reinterpret_cast<unsigned*>(static_cast<char*>(base) + offset);
+        }};
+        this->sq_head  = at(this->sq_ring, params.sq_off.head);
+        this->sq_tail  = at(this->sq_ring, params.sq_off.tail);
+        this->sq_mask  = *at(this->sq_ring, params.sq_off.ring_mask);
+        this->sq_flags = at(this->sq_ring, params.sq_off.flags);
+        this->sq_array = at(this->sq_ring, params.sq_off.array);
+        this->sq_count = params.sq_entries;
+        this->cq_head  = at(this->cq_ring, params.cq_off.head);
+        this->cq_tail  = at(this->cq_ring, params.cq_off.tail);
+        this->cq_mask  = *at(this->cq_ring, params.cq_off.ring_mask);
+        this->cqes     = reinterpret_cast<::io_uring_cqe*>(static_cast<char*>(this->cq_ring) + params.cq_off.cqes);
+
+        this->local_tail = *this->sq_tail;
+    }
+    auto mmap(::std::size_t size, ::off_t offset) -> void* {
+        void* ptr{::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ring, offset)};
+        if (ptr == MAP_FAILED) {
+            ::beman::task::detail::throw_exception(
+                ::std::system_error(errno, ::std::system_category(), "io_uring mmap"));
+        }
+        return ptr;
+    }
+    auto unmap() noexcept -> void {
+        if (this->sqes) {
+            ::munmap(this->sqes, this->sq_count * sizeof(::io_uring_sqe));
+        }
+        if (this->cq_ring && this->cq_ring != this->sq_ring) {
+            ::munmap(this->cq_ring, this->cq_size);
+        }
+        if (this->sq_ring) {
+            ::munmap(this->sq_ring, this->sq_size);
+        }
+        if (0 <= this->wakeup.fd) {
+            ::close(this->wakeup.fd);
+        }
+        ::close(this->ring);
+    }
+    auto do_register(unsigned opcode, const void* arg, unsigned count, const char* what) -> void {
+        if (::syscall(__NR_io_uring_register, this->ring, opcode, arg, count) < 0) {
+            ::beman::task::detail::throw_exception(::std::system_error(errno, ::std::system_category(), what));
+        }
+    }
+    auto enter(unsigned submit, unsigned wait, unsigned flags) noexcept -> int {
+        int rc;
+        do {
+            rc = int(::syscall(__NR_io_uring_enter, this->ring, submit, wait, flags, nullptr, 0));
+        } while (rc < 0 && errno == EINTR);
+        return rc;
+    }
+
+    auto push(node* n) noexcept -> void {
+        bool idle{};
+        {
+            ::std::lock_guard guard(this->mutex);
+            idle = this->head == nullptr;
+            (this->head ? this->tail->next : this->head) = n;
+            this->tail                                   = n;
+        }
+        // Only the first request of a batch needs to wake the thread up.
+        if (idle) {
+            this->notify();
+        }
+    }
+    auto notify() noexcept -> void {
+        ::std::uint64_t one{1u};
+        [[maybe_unused]] auto rc{::write(this->wakeup.fd, &one, sizeof(one))};
+    }
+
+    // Only used by the context's thread: the submission queue has a single producer.
+    auto add(node* n) noexcept -> void {
+        while (this->local_tail - ::std::atomic_ref<unsigned>(*this->sq_head).load(::std::memory_order_acquire) ==
+               this->sq_count) {
+            // The submission queue is full: hand the prepared entries to the kernel.
+            this->submit(0u);
+            if (this->sqpoll) {
+                ::std::this_thread::yield();
+            }
+        }
+        unsigned        index{this->local_tail & this->sq_mask};
+        ::io_uring_sqe& sqe{this->sqes[index]};
+        ::std::memset(&sqe, 0, sizeof(sqe));
+        n->prepare(sqe);
+        sqe.user_data         = reinterpret_cast<::std::uintptr_t>(n);
+        this->sq_array[index] = index;
+        ++this->local_tail;
+        ++this->unsubmitted;
+        if (n != &this->wakeup) {
+            ++this->inflight;
+        }
+    }
+    auto submit(unsigned wait) noexcept -> void {
+        ::std::atomic_ref<unsigned>(*this->sq_tail).store(this->local_tail, ::std::memory_order_release);
+        unsigned flags{wait ? unsigned(IORING_ENTER_GETEVENTS) : 0u};
+        unsigned count{this->unsubmitted};
+        if (this->sqpoll) {
+            count = 0u;
+            if (::std::atomic_ref<unsigned>(*this->sq_flags).load(::std::memory_order_acquire) &
+                IORING_SQ_NEED_WAKEUP) {
+                flags |= IORING_ENTER_SQ_WAKEUP;
+            }
+        }
+        this->unsubmitted = 0u;
+        if (count != 0u || wait != 0u || flags != 0u) {
+            this->enter(count, wait, flags);
+        }
+    }
+    auto reap() noexcept -> void {
+        ::std::atomic_ref<unsigned> tail(*this->cq_tail);
+        ::std::atomic_ref<unsigned> head(*this->cq_head);
+        for (unsigned h{head.load(::std::memory_order_relaxed)}; h != tail.load(::std::memory_order_acquire);) {
+            ::io_uring_cqe cqe{this->cqes[h & this->cq_mask]};
+            head.store(++h, ::std::memory_order_release);
+            auto* n{reinterpret_cast<node*>(static_cast<::std::uintptr_t>(cqe.user_data))};
+            if (n != &this->wakeup) {
+                --this->inflight;
+            }
+            n->complete(cqe.res);
+        }
+    }
+    auto run() -> void {
+        while (true) {
+            if (not this->wakeup.armed) {
+                this->add(&this->wakeup);
+            }
+            node* batch{};
+            bool  stop{};
+            {
+                ::std::lock_guard guard(this->mutex);
+                batch = ::std::exchange(this->head, nullptr);
+                stop  = this->done;
+            }
+            while (batch) {
+                this->add(::std::exchange(batch, batch->next));
+            }
+            if (stop && this->inflight == 0u) {
+                break;
+            }
+            this->submit(1u);
+            this->reap();
+        }
+    }
+
+    int             ring{-1};
+    bool            sqpoll{false};
+    ::std::size_t   sq_size{};
+    ::std::size_t   cq_size{};
+    void*           sq_ring{};
+    void*           cq_ring{};
+    ::io_uring_sqe* sqes{};
+    unsigned*       sq_head{};
+    unsigned*       sq_tail{};
+    unsigned*       sq_flags{};
+    unsigned*       sq_array{};
+    unsigned        sq_mask{};
+    unsigned        sq_count{};
+    unsigned*       cq_head{};
+    unsigned*       cq_tail{};
+    unsigned        cq_mask{};
+    ::io_uring_cqe* cqes{};
+    unsigned        local_tail{};
+    unsigned        unsubmitted{};
+    ::std::size_t   inflight{};
+    wakeup_node     wakeup;
+
+    ::std::mutex  mutex;
+    node*         head{};
+    node*         tail{};
+    bool          done{false};
+    ::std::thread thread;
+};
+
+/*!
+ * \brief Operation state of the `io_uring_context` senders
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ * \internal
+ *
+ * `Op` describes the request: it fills the SQE and turns a successful
+ * result into a `set_value` completion. When stop is requested, a cancel
+ * request referring to this operation is queued. The operation completes
+ * once its own CQE and, if it was issued, the CQE of the cancel request
+ * were received.
+ */
+template <typename Receiver, typename Op>
+struct io_uring_context::state : io_uring_context::node {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+
+    struct cancel_node : io_uring_context::node {
+        state* st;
+        explicit cancel_node(state* s) : st(s) {}
+        auto prepare(::io_uring_sqe& sqe) noexcept -> void override {
+            sqe.opcode = IORING_OP_ASYNC_CANCEL;
+            sqe.fd     = -1;
+            sqe.addr   = reinterpret_cast<::std::uintptr_t>(static_cast<io_uring_context::node*>(this->st));
+        }
+        auto complete(int) noexcept -> void override { this->st->finish(); }
+    };
+    struct stopper {
+        state* st;
+        auto   operator()() const noexcept -> void {
+            this->st->stopped.store(true, ::std::memory_order_relaxed);
+            this->st->pending.fetch_add(1u, ::std::memory_order_relaxed);
+            this->st->context->push(&this->st->cancel);
+        }
+    };
+    using stop_token_t =
+        decltype(::beman::execution::get_stop_token(::beman::execution::get_env(::std::declval<Receiver&>())));
+    using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stopper>;
+
+    ::std::remove_cvref_t<Receiver>  receiver;
+    io_uring_context*                context;
+    Op                               op;
+    cancel_node                      cancel{this};
+    ::std::optional<stop_callback_t> callback;
+    ::std::atomic<bool>              stopped{false};
+    ::std::atomic<unsigned>          pending{1u};
+    bool                             skipped{false};
+    int                              result{};
+
+    template <typename R>
+    state(R&& r, io_uring_context* c, Op o) : receiver(::std::forward<R>(r)), context(c), op(::std::move(o)) {}
+    state(state&&) = delete;
+
+    auto start() & noexcept -> void {
+        auto token{::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver))};
+        if (token.stop_requested()) {
+            ::beman::execution::set_stopped(::std::move(this->receiver));
+            return;
+        }
+        if (token.stop_possible()) {
+            this->callback.emplace(token, stopper{this});
+        }
+        this->context->push(this);
+    }
+    auto prepare(::io_uring_sqe& sqe) noexcept -> void override {
+        if (this->stopped.load(::std::memory_order_relaxed)) {
+            // Stop was requested before the request got submitted.
+            sqe.opcode    = IORING_OP_NOP;
+            this->skipped = true;
+        } else {
+            this->op.prepare(sqe);
+        }
+    }
+    auto complete(int res) noexcept -> void override {
+        this->callback.reset();
+        this->result = res;
+        this->finish();
+    }
+    auto finish() noexcept -> void {
+        if (1u != this->pending.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+            return;
+        }
+        if (this->skipped || this->result == -ECANCELED) {
+            ::beman::execution::set_stopped(::std::move(this->receiver));
+        } else if (this->result < 0) {
+            ::beman::execution::set_error(::std::move(this->receiver),
+                                          ::std::error_code(-this->result, ::std::system_category()));
+        } else {
+            this->op.complete(::std::move(this->receiver), this->result);
+        }
+    }
+};
+
+/*!
+ * \brief Sender of an `io_uring_context` operation
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ */
+template <typename Op>
+class io_uring_context::sender {
+  public:
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::completion_signatures<typename Op::value_signature,
+                                                                            ::beman::execution::set_error_t(
+                                                                                ::std::error_code),
+                                                                            ::beman::execution::set_stopped_t()>;
+
+    sender(io_uring_context* c, Op o) : context(c), op(::std::move(o)) {}
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) const -> io_uring_context::state<Receiver, Op> {
+        return io_uring_context::state<Receiver, Op>(::std::forward<Receiver>(receiver), this->context, this->op);
+    }
+    auto get_env() const noexcept;
+
+  private:
+    io_uring_context* context;
+    Op                op;
+};
+
+/*!
+ * \brief Scheduler of an `io_uring_context`
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ */
+class io_uring_context::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    struct env {
+        io_uring_context* context;
+
+        auto query(const ::beman::execution::get_completion_scheduler_t<::beman::execution::set_value_t>&)
+            const noexcept -> scheduler {
+            return scheduler(this->context);
+        }
+    };
+    // schedule() submits a no-op: the continuation runs on the context's thread.
+    struct nop_op {
+        using value_signature = ::beman::execution::set_value_t();
+        auto prepare(::io_uring_sqe& sqe) const noexcept -> void { sqe.opcode = IORING_OP_NOP; }
+        template <typename Receiver>
+        auto complete(Receiver&& receiver, int) const noexcept -> void {
+            ::beman::execution::set_value(::std::forward<Receiver>(receiver));
+        }
+    };
+
+    explicit scheduler(io_uring_context* c) : context(c) {}
+
+    auto schedule() const noexcept -> io_uring_context::sender<nop_op> { return {this->context, nop_op{}}; }
+    template <typename Op>
+    auto make_sender(Op op) const -> io_uring_context::sender<Op> {
+        return {this->context, ::std::move(op)};
+    }
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    io_uring_context* context;
+};
+
+template <typename Op>
+inline auto io_uring_context::sender<Op>::get_env() const noexcept {
+    return io_uring_context::scheduler::env{this->context};
+}
+
+inline auto io_uring_context::get_scheduler() -> scheduler { return scheduler(this); }
+
+using io_uring_scheduler = ::beman::task::detail::io_uring_context::scheduler;
+static_assert(::beman::execution::scheduler<io_uring_scheduler>);
+
+/*!
+ * \brief Helpers describing the io_uring requests
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ * \internal
+ */
+namespace io_uring_ops {
+inline auto set_file(::io_uring_sqe& sqe, int fd) noexcept -> void { sqe.fd = fd; }
+inline auto set_file(::io_uring_sqe& sqe, ::beman::task::detail::registered_file file) noexcept -> void {
+    sqe.fd = int(file.index);
+    sqe.flags |= IOSQE_FIXED_FILE;
+}
+
+template <typename File, typename Buffer, bool Write>
+struct transfer {
+    using value_signature = ::beman::execution::set_value_t(::std::size_t);
+
+    File            file;
+    Buffer          buffer;
+    ::std::uint64_t offset;
+
+    auto prepare(::io_uring_sqe& sqe) const noexcept -> void {
+        ::beman::task::detail::io_uring_ops::set_file(sqe, this->file);
+        sqe.off = this->offset;
+        if constexpr (::std::same_as<Buffer, ::beman::task::detail::registered_buffer>) {
+            sqe.opcode    = Write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe.addr      = reinterpret_cast<::std::uintptr_t>(this->buffer.data.data());
+            sqe.len       = unsigned(this->buffer.data.size());
+            sqe.buf_index = ::std::uint16_t(this->buffer.index);
+        } else {
+            sqe.opcode = Write ? IORING_OP_WRITE : IORING_OP_READ;
+            sqe.addr   = reinterpret_cast<::std::uintptr_t>(this->buffer.data());
+            sqe.len    = unsigned(this->buffer.size());
+        }
+    }
+    template <typename Receiver>
+    auto complete(Receiver&& receiver, int result) const noexcept -> void {
+        ::beman::execution::set_value(::std::forward<Receiver>(receiver), ::std::size_t(result));
+    }
+};
+
+template <typename File>
+struct fsync {
+    using value_signature = ::beman::execution::set_value_t();
+
+    File file;
+    bool datasync;
+
+    auto prepare(::io_uring_sqe& sqe) const noexcept -> void {
+        sqe.opcode = IORING_OP_FSYNC;
+        ::beman::task::detail::io_uring_ops::set_file(sqe, this->file);
+        sqe.fsync_flags = this->datasync ? IORING_FSYNC_DATASYNC : 0u;
+    }
+    template <typename Receiver>
+    auto complete(Receiver&& receiver, int) const noexcept -> void {
+        ::beman::execution::set_value(::std::forward<Receiver>(receiver));
+    }
+};
+
+struct openat {
+    using value_signature = ::beman::execution::set_value_t(int);
+
+    int           dirfd;
+    ::std::string path;
+    int           flags;
+    ::mode_t      mode;
+
+    auto prepare(::io_uring_sqe& sqe) const noexcept -> void {
+        sqe.opcode     = IORING_OP_OPENAT;
+        sqe.fd         = this->dirfd;
+        sqe.addr       = reinterpret_cast<::std::uintptr_t>(this->path.c_str());
+        sqe.len        = this->mode;
+        sqe.open_flags = ::std::uint32_t(this->flags);
+    }
+    template <typename Receiver>
+    auto complete(Receiver&& receiver, int fd) const noexcept -> void {
+        ::beman::execution::set_value(::std::forward<Receiver>(receiver), fd);
+    }
+};
+} // namespace io_uring_ops
+
+/*!
+ * \brief Customization point object reading from a file at an offset
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ *
+ * `async_read(scheduler, file, buffer, offset)` completes with the number
+ * of bytes read. `file` is a file descriptor or a `registered_file` and
+ * `buffer` is a `std::span<std::byte>` or a `registered_buffer`.
+ */
+struct async_read_t {
+    template <typename File>
+    auto operator()(::beman::task::detail::io_uring_scheduler sched,
+                    File                                       file,
+                    ::std::span<::std::byte>                   buffer,
+                    ::std::uint64_t                            offset) const {
+        return sched.make_sender(
+            ::beman::task::detail::io_uring_ops::transfer<File, ::std::span<::std::byte>, false>{
+                file, buffer, offset});
+    }
+    template <typename File>
+    auto operator()(::beman::task::detail::io_uring_scheduler sched,
+                    File                                       file,
+                    ::beman::task::detail::registered_buffer   buffer,
+                    ::std::uint64_t                            offset) const {
+        return sched.make_sender(
+            ::beman::task::detail::io_uring_ops::transfer<File, ::beman::task::detail::registered_buffer, false>{
+                file, buffer, offset});
+    }
+};
+
+/*!
+ * \brief Customization point object writing to a file at an offset
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ *
+ * `async_write(scheduler, file, buffer, offset)` completes with the number
+ * of bytes written. `file` is a file descriptor or a `registered_file` and
+ * `buffer` is a `std::span<const std::byte>` or a `registered_buffer`.
+ */
+struct async_write_t {
+    template <typename File>
+    auto operator()(::beman::task::detail::io_uring_scheduler sched,
+                    File                                       file,
+                    ::std::span<const ::std::byte>             buffer,
+                    ::std::uint64_t                            offset) const {
+        return sched.make_sender(
+            ::beman::task::detail::io_uring_ops::transfer<File, ::std::span<const ::std::byte>, true>{
+                file, buffer, offset});
+    }
+    template <typename File>
+    auto operator()(::beman::task::detail::io_uring_scheduler sched,
+                    File                                       file,
+                    ::beman::task::detail::registered_buffer   buffer,
+                    ::std::uint64_t                            offset) const {
+        return sched.make_sender(
+            ::beman::task::detail::io_uring_ops::transfer<File, ::beman::task::detail::registered_buffer, true>{
+                file, buffer, offset});
+    }
+};
+
+/*!
+ * \brief Customization point object flushing a file to storage
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ */
+struct async_fsync_t {
+    template <typename File>
+    auto operator()(::beman::task::detail::io_uring_scheduler sched, File file, bool datasync = false) const {
+        return sched.make_sender(::beman::task::detail::io_uring_ops::fsync<File>{file, datasync});
+    }
+};
+
+/*!
+ * \brief Customization point object opening a file
+ * \headerfile beman/task/io_uring_context.hpp <beman/task/io_uring_context.hpp>
+ *
+ * `async_openat(scheduler, dirfd, path, flags, mode)` completes with the
+ * new file descriptor.
+ */
+struct async_openat_t {
+    auto operator()(::beman::task::detail::io_uring_scheduler sched,
+                    int                                        dirfd,
+                    ::std::string                              path,
+                    int                                        flags,
+                    ::mode_t                                   mode = 0) const {
+        return sched.make_sender(
+            ::beman::task::detail::io_uring_ops::openat{dirfd, ::std::move(path), flags, mode});
+    }
+};
+
+inline constexpr async_read_t   async_read{};
+inline constexpr async_write_t  async_write{};
+inline constexpr async_fsync_t  async_fsync{};
+inline constexpr async_openat_t async_openat{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+#endif
@@ -4,32 +4,40 @@
 #ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_LOGGER
 #define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_LOGGER
 
-#include <algorithm>
-#include <iterator>
-#include <iostream>
+#include <beman/task/detail/trace.hpp>
 
 // ----------------------------------------------------------------------------
 
 namespace beman::task::detail {
+/*!
+ * \brief Debugging aid reporting the entry and exit of a scope
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * The construction and destruction of a logger are reported via
+ * `trace()` as the events `logger::enter` and `logger::exit` with the
+ * logger as object: a `trace_handler` recognises them by address and can
+ * get the scope's name from the logger's `msg`. Messages passed to `log()`
+ * are reported with the logger as object, too. A `trace_handler` can use
+ * `logger::level(0)` to indent the events by nesting.
+ */
 struct logger {
+    static constexpr const char* enter{"enter"};
+    static constexpr const char* exit{"exit"};
+
     static auto level(int i) -> int {
         static int rc{};
         return rc += i;
     }
-    ::std::ostream& log(const char* pre, const char* msg) {
-        ::std::fill_n(::std::ostreambuf_iterator<char>(std::cout.rdbuf()), level(0), ' ');
-        std::cout << pre;
-        return std::cout << msg << "\n";
-    }
-    ::std::ostream& log(const char* msg) { return log("| ", msg); }
-    const char*     msg;
+    auto        log(const char* m) const noexcept -> void { ::beman::task::detail::trace(m, this); }
+    const char* msg;
     explicit logger(const char* m) : msg(m) {
         level(1);
-        log("\\ ", this->msg);
+        this->log(logger::enter);
     }
     logger(logger&&) = delete;
     ~logger() {
-        log("/ ", this->msg);
+        this->log(logger::exit);
         level(-1);
     }
 };
@@ -0,0 +1,110 @@
+// include/beman/task/detail/meta.hpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_META
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_META
+
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail::meta {
+/*
+ * \brief Determine whether a type list contains a given type.
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+template <typename, typename>
+struct list_contains;
+template <template <typename...> class L, typename... E, typename T>
+struct list_contains<L<E...>, T> {
+    static constexpr bool value = (std::same_as<E, T> || ...);
+};
+template <typename L, typename T>
+inline constexpr bool list_contains_v{list_contains<L, T>::value};
+
+/*
+ * \brief Concatenate type lists using the same list template.
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+template <typename...>
+struct concat;
+template <template <typename...> class L, typename... T>
+struct concat<L<T...>> {
+    using type = L<T...>;
+};
+template <template <typename...> class L, typename... T0, typename... T1, typename... R>
+struct concat<L<T0...>, L<T1...>, R...> {
+    using type = typename concat<L<T0..., T1...>, R...>::type;
+};
+template <typename... L>
+using concat_t = typename concat<L...>::type;
+
+/*
+ * \brief Remove duplicates from a type list, keeping the first occurrence.
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+template <typename, typename>
+struct unique_helper;
+template <template <typename...> class L, typename... R>
+struct unique_helper<L<R...>, L<>> {
+    using type = L<R...>;
+};
+template <template <typename...> class L, typename... R, typename H, typename... T>
+struct unique_helper<L<R...>, L<H, T...>> {
+    using type =
+        typename unique_helper<std::conditional_t<(std::same_as<H, R> || ...), L<R...>, L<R..., H>>, L<T...>>::type;
+};
+template <typename>
+struct unique;
+template <template <typename...> class L, typename... T>
+struct unique<L<T...>> : unique_helper<L<>, L<T...>> {};
+template <typename L>
+using unique_t = typename unique<L>::type;
+
+/*
+ * \brief Turn a list of completion signatures into a variant which can hold
+ *  the decayed arguments of any of the completions.
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * The first alternative is `std::monostate` indicating that no completion
+ * was stored, yet. Each completion `Tag(A...)` is stored as a
+ * `std::tuple<Tag, std::decay_t<A>...>`.
+ */
+template <typename>
+struct as_tuple;
+template <typename Tag, typename... A>
+struct as_tuple<Tag(A...)> {
+    using type = ::std::tuple<Tag, ::std::decay_t<A>...>;
+};
+template <typename Sig>
+using as_tuple_t = typename as_tuple<Sig>::type;
+
+template <typename...>
+struct type_list {};
+
+template <typename>
+struct completion_variant;
+template <template <typename...> class L, typename... Sig>
+struct completion_variant<L<Sig...>> {
+    template <typename>
+    struct to_variant;
+    template <typename... T>
+    struct to_variant<type_list<T...>> {
+        using type = ::std::variant<T...>;
+    };
+    using type = typename to_variant<unique_t<type_list<::std::monostate, as_tuple_t<Sig>...>>>::type;
+};
+template <typename Signatures>
+using completion_variant_t = typename completion_variant<Signatures>::type;
+} // namespace beman::task::detail::meta
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,420 @@
+// include/beman/task/detail/parallel_for.hpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_PARALLEL_FOR
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_PARALLEL_FOR
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/schedule_bulk.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Operation running the chunks of a range on a scheduler
+ * \headerfile beman/task/parallel_for.hpp <beman/task/parallel_for.hpp>
+ * \internal
+ *
+ * The range is split into chunks of at most `chunk` elements. If the
+ * scheduler supports bulk submission natively, i.e., it has a member
+ * `schedule_bulk()` and, for a `task_scheduler`, the underlying scheduler
+ * has, the chunks are run by one `schedule_bulk` operation costing one
+ * submission. Otherwise, one `schedule` operation per chunk is submitted
+ * at once when the operation is started. The `Work` object processes
+ * chunks using `run(index, first, last)` and produces the result of the
+ * operation using `complete(receiver)` once all chunks are done. If a
+ * chunk fails, stop is requested for the remaining chunks and the first
+ * error is reported. Stop requests of the receiver are forwarded to the
+ * chunks: chunks not started, yet, are skipped.
+ */
+template <typename Receiver, typename Scheduler, typename View, typename Work>
+struct parallel_chunks_state {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+
+    struct env {
+        const parallel_chunks_state* st;
+        auto query(const ::beman::execution::get_stop_token_t&) const noexcept
+            -> ::beman::execution::inplace_stop_token {
+            return this->st->source.get_token();
+        }
+    };
+    struct chunk_receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        parallel_chunks_state* st;
+        ::std::size_t          index;
+
+        auto set_value() && noexcept -> void {
+            this->st->run(this->index);
+            this->st->finish();
+        }
+        template <typename E>
+        auto set_error(E&& error) && noexcept -> void {
+            this->st->fail(::std::forward<E>(error));
+            this->st->finish();
+        }
+        auto set_stopped() && noexcept -> void {
+            this->st->skip();
+            this->st->finish();
+        }
+        auto get_env() const noexcept -> env { return {this->st}; }
+    };
+    struct chunk_function {
+        parallel_chunks_state* st;
+        auto                   operator()(::std::size_t index) const noexcept -> void { this->st->run(index); }
+    };
+    struct bulk_receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        parallel_chunks_state* st;
+
+        auto set_value() && noexcept -> void { this->st->finish(); }
+        template <typename E>
+        auto set_error(E&& error) && noexcept -> void {
+            this->st->fail(::std::forward<E>(error));
+            this->st->finish();
+        }
+        auto set_stopped() && noexcept -> void {
+            this->st->skip();
+            this->st->finish();
+        }
+        auto get_env() const noexcept -> env { return {this->st}; }
+    };
+    struct bulk {
+        using op_t = decltype(::beman::execution::connect(
+            ::beman::task::detail::schedule_bulk(
+                ::std::declval<Scheduler&>(), ::std::size_t(), ::std::declval<chunk_function>()),
+            ::std::declval<bulk_receiver>()));
+        op_t op;
+        explicit bulk(parallel_chunks_state* st)
+            : op(::beman::execution::connect(
+                  ::beman::task::detail::schedule_bulk(st->scheduler, st->count, chunk_function{st}),
+                  bulk_receiver{st})) {}
+    };
+    struct chunk {
+        using op_t = decltype(::beman::execution::connect(::beman::execution::schedule(::std::declval<Scheduler&>()),
+                                                          ::std::declval<chunk_receiver>()));
+        op_t op;
+        chunk(parallel_chunks_state* st, ::std::size_t index)
+            : op(::beman::execution::connect(::beman::execution::schedule(st->scheduler),
+                                             chunk_receiver{st, index})) {}
+    };
+    struct stop_link {
+        ::beman::execution::inplace_stop_source& source;
+        auto operator()() const noexcept -> void { this->source.request_stop(); }
+    };
+    using stop_token_t =
+        decltype(::beman::execution::get_stop_token(::beman::execution::get_env(::std::declval<Receiver&>())));
+    using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stop_link>;
+
+    Receiver                                    receiver;
+    Scheduler                                   scheduler;
+    View                                        view;
+    ::std::size_t                               chunk_size;
+    ::std::size_t                               count;
+    Work                                        work;
+    ::beman::execution::inplace_stop_source     source;
+    ::std::optional<stop_callback_t>            stop_callback;
+    ::std::atomic<::std::size_t>                remaining;
+    ::std::atomic<bool>                         failed{false};
+    ::std::atomic<bool>                         skipped{false};
+    ::std::exception_ptr                        error;
+    ::std::unique_ptr<::std::optional<chunk>[]> chunks;
+    ::std::optional<bulk>                       bulk_op;
+
+    template <typename R, typename W>
+    parallel_chunks_state(R&& r, Scheduler sched, View v, ::std::size_t size, W&& w)
+        : receiver(::std::forward<R>(r)),
+          scheduler(::std::move(sched)),
+          view(::std::move(v)),
+          chunk_size(::std::max(size, ::std::size_t(1u))),
+          count((::std::size_t(::std::ranges::size(this->view)) + this->chunk_size - 1u) / this->chunk_size),
+          work(::std::forward<W>(w), this->count),
+          remaining(this->count) {}
+    parallel_chunks_state(parallel_chunks_state&&) = delete;
+
+    auto start() & noexcept -> void {
+        if (this->count == 0u) {
+            this->complete();
+            return;
+        }
+        if (parallel_chunks_state::native_bulk(this->scheduler)) {
+            this->start_bulk();
+            return;
+        }
+        BEMAN_TASK_TRY {
+            this->chunks.reset(new ::std::optional<chunk>[this->count]);
+            for (::std::size_t i{}; i != this->count; ++i) {
+                this->chunks[i].emplace(this, i);
+            }
+        }
+        BEMAN_TASK_CATCH_ALL {
+            this->chunks.reset();
+            ::beman::execution::set_error(::std::move(this->receiver), ::std::current_exception());
+            return;
+        }
+        this->stop_callback.emplace(::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver)),
+                                    stop_link{this->source});
+        // The last chunk to finish completes the operation which may destroy
+        // this object: nothing may be accessed after starting the last chunk.
+        for (::std::size_t i{}, n{this->count}; i != n; ++i) {
+            ::beman::execution::start(this->chunks[i]->op);
+        }
+    }
+
+    auto start_bulk() noexcept -> void {
+        BEMAN_TASK_TRY {
+            this->bulk_op.emplace(this);
+        }
+        BEMAN_TASK_CATCH_ALL {
+            ::beman::execution::set_error(::std::move(this->receiver), ::std::current_exception());
+            return;
+        }
+        // the bulk operation completes once after all chunks ran
+        this->remaining.store(1u, ::std::memory_order_relaxed);
+        this->stop_callback.emplace(::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver)),
+                                    stop_link{this->source});
+        ::beman::execution::start(this->bulk_op->op);
+    }
+    static auto native_bulk(Scheduler& sched) noexcept -> bool {
+        if constexpr (requires { sched.has_native_schedule_bulk(); }) {
+            return sched.has_native_schedule_bulk();
+        } else {
+            return requires { sched.schedule_bulk(::std::size_t(), ::std::declval<chunk_function>()); };
+        }
+    }
+
+    // Process a chunk: the caller accounts for its completion using finish().
+    auto run(::std::size_t index) noexcept -> void {
+        if (this->source.stop_requested()) {
+            this->skip();
+            return;
+        }
+        auto offset{index * this->chunk_size};
+        auto first{::std::ranges::begin(this->view) + offset};
+        auto size{::std::min(this->chunk_size, ::std::size_t(::std::ranges::size(this->view)) - offset)};
+        BEMAN_TASK_TRY {
+            this->work.run(index, first, first + size);
+        }
+        BEMAN_TASK_CATCH_ALL {
+            this->fail(::std::current_exception());
+        }
+    }
+    template <typename E>
+    auto fail(E&& error) noexcept -> void {
+        if (not this->failed.exchange(true, ::std::memory_order_acq_rel)) {
+            if constexpr (::std::same_as<::std::remove_cvref_t<E>, ::std::exception_ptr>) {
+                this->error = ::std::forward<E>(error);
+            } else {
+                this->error = ::std::make_exception_ptr(::std::forward<E>(error));
+            }
+            this->source.request_stop();
+        }
+    }
+    auto skip() noexcept -> void { this->skipped.store(true, ::std::memory_order_relaxed); }
+    auto finish() noexcept -> void {
+        if (1u == this->remaining.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+            this->stop_callback.reset();
+            this->complete();
+        }
+    }
+    auto complete() noexcept -> void {
+        if (this->failed.load(::std::memory_order_relaxed)) {
+            ::beman::execution::set_error(::std::move(this->receiver), ::std::move(this->error));
+        } else if (this->skipped.load(::std::memory_order_relaxed)) {
+            ::beman::execution::set_stopped(::std::move(this->receiver));
+        } else {
+            this->work.complete(::std::move(this->receiver));
+        }
+    }
+};
+
+/*!
+ * \brief Sender for the parallel algorithms
+ * \headerfile beman/task/parallel_for.hpp <beman/task/parallel_for.hpp>
+ * \internal
+ */
+template <typename Scheduler, typename View, typename Work>
+struct parallel_chunks_sender {
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::completion_signatures<typename Work::value_signature,
+                                                                            ::beman::execution::set_error_t(
+                                                                                ::std::exception_ptr),
+                                                                            ::beman::execution::set_stopped_t()>;
+
+    Scheduler                 scheduler;
+    View                      view;
+    ::std::size_t             chunk;
+    typename Work::parameters parameters;
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) && {
+        return ::beman::task::detail::parallel_chunks_state<::std::remove_cvref_t<Receiver>, Scheduler, View, Work>(
+            ::std::forward<Receiver>(receiver),
+            ::std::move(this->scheduler),
+            ::std::move(this->view),
+            this->chunk,
+            ::std::move(this->parameters));
+    }
+};
+
+template <typename Fn>
+struct parallel_for_work {
+    using value_signature = ::beman::execution::set_value_t();
+    using parameters      = Fn;
+
+    Fn fn;
+
+    parallel_for_work(Fn&& f, ::std::size_t) : fn(::std::move(f)) {}
+    template <typename Iterator>
+    auto run(::std::size_t, Iterator first, Iterator last) -> void {
+        for (; first != last; ++first) {
+            ::std::invoke(this->fn, *first);
+        }
+    }
+    template <typename Receiver>
+    auto complete(Receiver&& receiver) noexcept -> void {
+        ::beman::execution::set_value(::std::forward<Receiver>(receiver));
+    }
+};
+
+template <typename T, typename Reduce, typename Transform>
+struct transform_reduce_work {
+    using value_signature = ::beman::execution::set_value_t(T);
+    struct parameters {
+        T         init;
+        Reduce    reduce;
+        Transform transform;
+    };
+    // Each chunk writes its partial result into its own cache line.
+    struct alignas(64) slot {
+        ::std::optional<T> value;
+    };
+
+    parameters                params;
+    ::std::size_t             count;
+    ::std::unique_ptr<slot[]> slots;
+
+    transform_reduce_work(parameters&& p, ::std::size_t n)
+        : params(::std::move(p)), count(n), slots(n == 0u ? nullptr : new slot[n]) {}
+    template <typename Iterator>
+    auto run(::std::size_t index, Iterator first, Iterator last) -> void {
+        T acc(::std::invoke(this->params.transform, *first));
+        while (++first != last) {
+            acc = ::std::invoke(this->params.reduce, ::std::move(acc), ::std::invoke(this->params.transform, *first));
+        }
+        this->slots[index].value.emplace(::std::move(acc));
+    }
+    template <typename Receiver>
+    auto complete(Receiver&& receiver) noexcept -> void {
+        BEMAN_TASK_TRY {
+            T result(::std::move(this->params.init));
+            for (::std::size_t i{}; i != this->count; ++i) {
+                result = ::std::invoke(this->params.reduce, ::std::move(result), ::std::move(*this->slots[i].value));
+            }
+            ::beman::execution::set_value(::std::forward<Receiver>(receiver), ::std::move(result));
+        }
+        BEMAN_TASK_CATCH_ALL {
+            ::beman::execution::set_error(::std::forward<Receiver>(receiver), ::std::current_exception());
+        }
+    }
+};
+
+/*!
+ * \brief Sender algorithm invoking a function on all elements of a range in parallel
+ * \headerfile beman/task/parallel_for.hpp <beman/task/parallel_for.hpp>
+ *
+ * The sender `parallel_for(sched, range, chunk, fn)` splits the random
+ * access `range` into chunks of `chunk` elements. All chunks are submitted
+ * to the scheduler `sched` when the sender is started, using one
+ * `schedule_bulk` operation if `sched` supports it natively. `fn` is
+ * invoked on each element of a chunk on the execution agent running the
+ * chunk.
+ * The sender completes with `set_value()` once all chunks are processed.
+ * If any invocation of `fn` throws, stop is requested for the chunks not
+ * started, yet, and the sender completes with the first exception. If
+ * stop is requested by the receiver, chunks not started are skipped and
+ * the sender completes with `set_stopped()`.
+ *
+ * When `co_await`ed from a `task` the task resumes on its own scheduler.
+ * An lvalue range is referenced and needs to stay alive until the sender
+ * completes.
+ *
+ * Usage:
+ *
+ *     co_await parallel_for(pool.get_scheduler(), candidates, 1024, [](auto& c) { c.score = score(c); });
+ */
+struct parallel_for_t {
+    template <::beman::execution::scheduler Scheduler, ::std::ranges::random_access_range Range, typename Fn>
+        requires ::std::ranges::sized_range<Range> && ::std::ranges::viewable_range<Range>
+    auto operator()(Scheduler&& sched, Range&& range, ::std::size_t chunk, Fn&& fn) const {
+        using view_t = ::std::views::all_t<Range>;
+        using work_t = ::beman::task::detail::parallel_for_work<::std::decay_t<Fn>>;
+        return ::beman::task::detail::parallel_chunks_sender<::std::remove_cvref_t<Scheduler>, view_t, work_t>{
+            ::std::forward<Scheduler>(sched),
+            ::std::views::all(::std::forward<Range>(range)),
+            chunk,
+            ::std::forward<Fn>(fn)};
+    }
+};
+
+/*!
+ * \brief Sender algorithm for a parallel transform/reduce over a range
+ * \headerfile beman/task/parallel_for.hpp <beman/task/parallel_for.hpp>
+ *
+ * The sender `parallel_transform_reduce(sched, range, chunk, init, reduce, transform)`
+ * processes the chunks of `range` like `parallel_for`. Each chunk
+ * computes a partial result by reducing the transformed elements. The
+ * partial results are kept in separate cache lines and are combined,
+ * starting with `init`, in the order of the chunks once all chunks are
+ * done. The sender completes with `set_value(T)` where `T` is the
+ * decayed type of `init`. `reduce` needs to be associative but doesn't
+ * need to be commutative.
+ *
+ * Usage:
+ *
+ *     auto total{co_await parallel_transform_reduce(sched, candidates, 1024, 0.0, std::plus<>(), score)};
+ */
+struct parallel_transform_reduce_t {
+    template <::beman::execution::scheduler Scheduler,
+              ::std::ranges::random_access_range Range,
+              typename T,
+              typename Reduce,
+              typename Transform>
+        requires ::std::ranges::sized_range<Range> && ::std::ranges::viewable_range<Range>
+    auto operator()(Scheduler&&   sched,
+                    Range&&       range,
+                    ::std::size_t chunk,
+                    T&&           init,
+                    Reduce&&      reduce,
+                    Transform&&   transform) const {
+        using view_t = ::std::views::all_t<Range>;
+        using work_t = ::beman::task::detail::
+            transform_reduce_work<::std::decay_t<T>, ::std::decay_t<Reduce>, ::std::decay_t<Transform>>;
+        return ::beman::task::detail::parallel_chunks_sender<::std::remove_cvref_t<Scheduler>, view_t, work_t>{
+            ::std::forward<Scheduler>(sched),
+            ::std::views::all(::std::forward<Range>(range)),
+            chunk,
+            typename work_t::parameters{
+                ::std::forward<T>(init), ::std::forward<Reduce>(reduce), ::std::forward<Transform>(transform)}};
+    }
+};
+
+inline constexpr parallel_for_t              parallel_for{};
+inline constexpr parallel_transform_reduce_t parallel_transform_reduce{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,326 @@
+// include/beman/task/detail/priority_scheduler.hpp                   -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_PRIORITY_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_PRIORITY_SCHEDULER
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/get_priority.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Worker pool executing work according to priority lanes
+ * \headerfile beman/task/priority_scheduler.hpp <beman/task/priority_scheduler.hpp>
+ *
+ * A `priority_context` runs a number of worker threads processing work
+ * items queued on a number of lanes. Workers take work from the most
+ * urgent non-empty lane (lane `0` being the most urgent). To prevent
+ * starvation, work which waited longer than the aging threshold is taken
+ * first, oldest first, independent of its lane.
+ *
+ * The schedulers obtained from `get_scheduler(lane)` schedule work on
+ * `lane` unless the environment of the receiver provides a `get_priority`
+ * query in which case the lane is taken from the environment. Lanes
+ * beyond the number of lanes are mapped to the least urgent lane.
+ *
+ * The schedulers support `schedule_bulk(count, fn)`: one work item per
+ * worker is queued with one lock acquisition and one notification and the
+ * items claim the indices from a shared counter.
+ *
+ * Usage:
+ *
+ *     priority_context pool(4);
+ *     ex::sync_wait(ex::starts_on(pool.get_scheduler(0), rpc_continuation()));
+ */
+class priority_context {
+  public:
+    using clock_type = ::std::chrono::steady_clock;
+
+    class scheduler;
+
+    explicit priority_context(::std::size_t        threads = 1u,
+                              ::std::size_t        lanes   = 3u,
+                              clock_type::duration age     = ::std::chrono::milliseconds(10))
+        : queues(::std::max(lanes, ::std::size_t(1u))), aging(age) {
+        for (::std::size_t i{}, n{::std::max(threads, ::std::size_t(1u))}; i != n; ++i) {
+            this->workers.emplace_back([this] { this->run(); });
+        }
+    }
+    priority_context(const priority_context&)            = delete;
+    priority_context& operator=(const priority_context&) = delete;
+    ~priority_context() {
+        this->finish();
+        for (auto& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+    auto get_scheduler(::std::size_t lane = 0u) -> scheduler;
+    auto lanes() const noexcept -> ::std::size_t { return this->queues.size(); }
+    /*!
+     * \brief Let the workers exit once all queued work is done.
+     */
+    auto finish() -> void {
+        {
+            ::std::lock_guard guard(this->mutex);
+            this->done = true;
+        }
+        this->condition.notify_all();
+    }
+
+  private:
+    struct node {
+        node*                  next{};
+        clock_type::time_point enqueued{};
+        virtual auto           run() noexcept -> void = 0;
+
+      protected:
+        ~node() = default;
+    };
+    struct queue {
+        node* head{};
+        node* tail{};
+    };
+
+    auto push(node* n, ::std::size_t lane) -> void {
+        n->next     = nullptr;
+        n->enqueued = clock_type::now();
+        {
+            ::std::lock_guard guard(this->mutex);
+            queue&            q{this->queues[::std::min(lane, this->queues.size() - 1u)]};
+            (q.tail ? q.tail->next : q.head) = n;
+            q.tail                           = n;
+        }
+        this->condition.notify_one();
+    }
+    template <typename Nodes>
+    auto push_all(Nodes& nodes, ::std::size_t lane) -> void {
+        auto now{clock_type::now()};
+        {
+            ::std::lock_guard guard(this->mutex);
+            queue&            q{this->queues[::std::min(lane, this->queues.size() - 1u)]};
+            for (node& item : nodes) {
+                node* n{&item};
+                n->next                          = nullptr;
+                n->enqueued                      = now;
+                (q.tail ? q.tail->next : q.head) = n;
+                q.tail                           = n;
+            }
+        }
+        this->condition.notify_all();
+    }
+    // The caller holds the lock and there is at least one queued node.
+    auto pick() -> queue& {
+        auto   limit{clock_type::now() - this->aging};
+        queue* urgent{};
+        queue* aged{};
+        for (auto& q : this->queues) {
+            if (q.head == nullptr) {
+                continue;
+            }
+            if (urgent == nullptr) {
+                urgent = &q;
+            }
+            if (q.head->enqueued <= limit && (aged == nullptr || q.head->enqueued < aged->head->enqueued)) {
+                aged = &q;
+            }
+        }
+        return aged ? *aged : *urgent;
+    }
+    auto pop() -> node* {
+        ::std::unique_lock guard(this->mutex);
+        auto              ready{[this] {
+            return ::std::any_of(this->queues.begin(), this->queues.end(), [](const queue& q) { return q.head; });
+        }};
+        this->condition.wait(guard, [this, &ready] { return this->done || ready(); });
+        if (not ready()) {
+            return nullptr;
+        }
+        queue& q{this->pick()};
+        node*  n{q.head};
+        q.head = n->next;
+        if (q.head == nullptr) {
+            q.tail = nullptr;
+        }
+        return n;
+    }
+    auto run() -> void {
+        while (node* n = this->pop()) {
+            n->run();
+        }
+    }
+
+    ::std::mutex                 mutex;
+    ::std::condition_variable    condition;
+    ::std::vector<queue>         queues;
+    clock_type::duration         aging;
+    bool                         done{false};
+    ::std::vector<::std::thread> workers;
+};
+
+/*!
+ * \brief Scheduler for a lane of a `priority_context`
+ * \headerfile beman/task/priority_scheduler.hpp <beman/task/priority_scheduler.hpp>
+ */
+class priority_context::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    struct env {
+        priority_context* context;
+        ::std::size_t     lane;
+
+        auto query(const ::beman::execution::get_completion_scheduler_t<::beman::execution::set_value_t>&)
+            const noexcept -> scheduler {
+            return {this->context, this->lane};
+        }
+    };
+    template <::beman::execution::receiver Receiver>
+    struct state : priority_context::node {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        ::std::remove_cvref_t<Receiver> receiver;
+        priority_context*               context;
+        ::std::size_t                   lane;
+
+        template <typename R>
+        state(R&& r, priority_context* c, ::std::size_t l) : receiver(::std::forward<R>(r)), context(c), lane(l) {}
+        auto start() & noexcept -> void { this->context->push(this, this->lane); }
+        auto run() noexcept -> void override { ::beman::execution::set_value(::std::move(this->receiver)); }
+    };
+    struct sender {
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t()>;
+
+        priority_context* context;
+        ::std::size_t     lane;
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) const -> state<Receiver> {
+            ::std::size_t l{
+                ::beman::task::detail::priority_of(::beman::execution::get_env(receiver)).value_or(this->lane)};
+            return state<Receiver>(::std::forward<Receiver>(receiver), this->context, l);
+        }
+        auto get_env() const noexcept -> env { return {this->context, this->lane}; }
+    };
+    template <::beman::execution::receiver Receiver, typename Fn>
+    struct bulk_state {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        struct part : priority_context::node {
+            bulk_state* st;
+            explicit part(bulk_state* s) : st(s) {}
+            auto run() noexcept -> void override { this->st->work(); }
+        };
+
+        ::std::remove_cvref_t<Receiver> receiver;
+        priority_context*               context;
+        ::std::size_t                   lane;
+        ::std::size_t                   count;
+        Fn                              fn;
+        ::std::vector<part>             parts;
+        ::std::atomic<::std::size_t>    next{0u};
+        ::std::atomic<::std::size_t>    remaining;
+        ::std::atomic<bool>             failed{false};
+        ::std::exception_ptr            error;
+
+        template <typename R, typename F>
+        bulk_state(R&& r, priority_context* c, ::std::size_t l, ::std::size_t n, F&& f)
+            : receiver(::std::forward<R>(r)),
+              context(c),
+              lane(l),
+              count(n),
+              fn(::std::forward<F>(f)),
+              remaining(::std::min(n, c->workers.size())) {
+            this->parts.reserve(this->remaining);
+            for (::std::size_t i{}, k{this->remaining}; i != k; ++i) {
+                this->parts.emplace_back(this);
+            }
+        }
+        bulk_state(bulk_state&&) = delete;
+
+        auto start() & noexcept -> void {
+            if (this->count == 0u) {
+                ::beman::execution::set_value(::std::move(this->receiver));
+                return;
+            }
+            this->context->push_all(this->parts, this->lane);
+        }
+        auto work() noexcept -> void {
+            for (::std::size_t i; (i = this->next.fetch_add(1u, ::std::memory_order_relaxed)) < this->count;) {
+                BEMAN_TASK_TRY {
+                    this->fn(i);
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    if (not this->failed.exchange(true, ::std::memory_order_acq_rel)) {
+                        this->error = ::std::current_exception();
+                    }
+                }
+            }
+            if (1u == this->remaining.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+                if (this->failed.load(::std::memory_order_relaxed)) {
+                    ::beman::execution::set_error(::std::move(this->receiver), ::std::move(this->error));
+                } else {
+                    ::beman::execution::set_value(::std::move(this->receiver));
+                }
+            }
+        }
+    };
+    template <typename Fn>
+    struct bulk_sender {
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t(),
+                                                                                ::beman::execution::set_error_t(
+                                                                                    ::std::exception_ptr)>;
+
+        priority_context* context;
+        ::std::size_t     lane;
+        ::std::size_t     count;
+        Fn                fn;
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) && -> bulk_state<Receiver, Fn> {
+            ::std::size_t l{
+                ::beman::task::detail::priority_of(::beman::execution::get_env(receiver)).value_or(this->lane)};
+            return bulk_state<Receiver, Fn>(
+                ::std::forward<Receiver>(receiver), this->context, l, this->count, ::std::move(this->fn));
+        }
+        auto get_env() const noexcept -> env { return {this->context, this->lane}; }
+    };
+
+    scheduler(priority_context* c, ::std::size_t l) : context(c), lane(l) {}
+
+    auto schedule() const noexcept -> sender { return {this->context, this->lane}; }
+    template <typename Fn>
+    auto schedule_bulk(::std::size_t count, Fn&& fn) const -> bulk_sender<::std::decay_t<Fn>> {
+        return {this->context, this->lane, count, ::std::forward<Fn>(fn)};
+    }
+    auto get_lane() const noexcept -> ::std::size_t { return this->lane; }
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    priority_context* context;
+    ::std::size_t     lane;
+};
+
+inline auto priority_context::get_scheduler(::std::size_t lane) -> scheduler { return {this, lane}; }
+
+using priority_scheduler = ::beman::task::detail::priority_context::scheduler;
+static_assert(::beman::execution::scheduler<priority_scheduler>);
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -9,66 +9,94 @@
 #include <beman/task/detail/allocator_of.hpp>
 #include <beman/task/detail/allocator_support.hpp>
 #include <beman/task/detail/change_coroutine_scheduler.hpp>
+#include <beman/task/detail/error_code.hpp>
 #include <beman/task/detail/error_types_of.hpp>
+#include <beman/task/detail/exceptions.hpp>
 #include <beman/task/detail/final_awaiter.hpp>
 #include <beman/task/detail/find_allocator.hpp>
+#include <beman/task/detail/forward_error_codes.hpp>
+#include <beman/task/detail/forward_errors_of.hpp>
+#include <beman/task/detail/frame_cache.hpp>
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+#include <beman/task/detail/frame_registry.hpp>
+#endif
 #include <beman/task/detail/handle.hpp>
 #include <beman/task/detail/inline_scheduler.hpp>
+#include <beman/task/detail/meta.hpp>
 #include <beman/task/detail/promise_base.hpp>
+#include <beman/task/detail/recycle_frames_of.hpp>
+#include <beman/task/detail/report_error_codes_of.hpp>
 #include <beman/task/detail/result_type.hpp>
+#include <beman/task/detail/resumption_budget_of.hpp>
 #include <beman/task/detail/scheduler_of.hpp>
 #include <beman/task/detail/state_base.hpp>
 #include <beman/task/detail/with_error.hpp>
+#include <beman/task/detail/yield.hpp>
 #include <beman/execution/execution.hpp>
 #include <beman/execution/detail/meta_contains.hpp>
 #include <beman/task/detail/promise_env.hpp>
 #include <coroutine>
+#include <cstddef>
 #include <optional>
+#include <source_location>
+#include <system_error>
 #include <type_traits>
 
 // ----------------------------------------------------------------------------
 
 namespace beman::task::detail {
-namespace meta {
-template <typename, typename>
-struct list_contains;
-template <template <typename...> class L, typename... E, typename T>
-struct list_contains<L<E...>, T> {
-    static constexpr bool value = (std::same_as<E, T> || ...);
-};
-template <typename L, typename T>
-inline constexpr bool list_contains_v{list_contains<L, T>::value};
-} // namespace meta
-
 template <typename Coroutine, typename Value, typename Environment>
 class promise_type
     : public ::beman::task::detail::
           promise_base<::beman::task::detail::stoppable::yes, ::std::remove_cvref_t<Value>, Environment>,
-      public ::beman::task::detail::allocator_support<::beman::task::detail::allocator_of_t<Environment>> {
+      public ::beman::task::detail::allocator_support<::beman::task::detail::allocator_of_t<Environment>,
+                                                      ::beman::task::detail::recycle_frames_of_v<Environment>> {
   public:
     using allocator_type   = ::beman::task::detail::allocator_of_t<Environment>;
     using scheduler_type   = ::beman::task::detail::scheduler_of_t<Environment>;
     using stop_source_type = ::beman::task::detail::stop_source_of_t<Environment>;
     using stop_token_type  = decltype(std::declval<stop_source_type>().get_token());
+    using error_types      = ::beman::task::detail::error_types_of_t<Environment>;
+    static constexpr ::std::size_t resumption_budget{::beman::task::detail::resumption_budget_of_v<Environment>};
+    static constexpr bool          report_error_codes{
+        ::beman::task::detail::report_error_codes_of_v<Environment> &&
+        ::beman::task::detail::meta::list_contains_v<error_types, ::beman::execution::set_error_t(::std::error_code)>};
+    static constexpr bool recycle_frames{::beman::task::detail::recycle_frames_of_v<Environment>};
 
     template <typename... A>
     promise_type(const A&... a) : allocator(::beman::task::detail::find_allocator<allocator_type>(a...)) {}
 
-    constexpr auto initial_suspend() noexcept -> ::std::suspend_always { return {}; }
-    constexpr auto final_suspend() noexcept -> ::beman::task::detail::final_awaiter { return {}; }
+    auto           initial_suspend() noexcept {
+        return this->recycling([] { return ::std::suspend_always{}; });
+    }
+    auto           final_suspend() noexcept -> ::beman::task::detail::final_awaiter {
+        this->stop_recycling();
+        return {};
+    }
 
     auto unhandled_exception() noexcept -> void {
-        using error_types = ::beman::task::detail::error_types_of_t<Environment>;
         if constexpr (::beman::task::detail::meta::
                           list_contains_v<error_types, ::beman::execution::set_error_t(::std::exception_ptr)>) {
             this->get_state()->set_error(::std::current_exception());
         } else {
-            std::terminate();
+            ::beman::task::detail::unhandled_failure();
         }
     }
     std::coroutine_handle<> unhandled_stopped() { return this->get_state()->complete(); }
 
-    auto get_return_object() noexcept { return Coroutine(::beman::task::detail::handle<promise_type>(this)); }
+    // If creating the coroutine object throws, e.g., because a shared_task
+    // fails to allocate its state, the exception propagates to the caller.
+    // The default argument is evaluated in the coroutine, i.e., `location`
+    // identifies the coroutine in the frame_registry.
+    auto get_return_object([[maybe_unused]] const ::std::source_location& location =
+                               ::std::source_location::current()) noexcept(noexcept(Coroutine(
+        ::std::declval<::beman::task::detail::handle<promise_type>>()))) {
+#ifdef BEMAN_TASK_FRAME_SIZE_REGISTRY
+        ::beman::task::detail::frame_registry::instance().identify(
+            ::std::coroutine_handle<promise_type>::from_promise(*this).address(), location);
+#endif
+        return Coroutine(::beman::task::detail::handle<promise_type>(this));
+    }
 
     template <::beman::execution::sender Sender, typename... A>
     auto await_transform(Sender&& sender) noexcept {
@@ -76,18 +104,87 @@ class promise_type
                           ::std::forward<Sender>(sender).as_awaitable(*this);
                           typename ::std::remove_cvref_t<Sender>::task_concept;
                       }) {
-            return ::std::forward<Sender>(sender).as_awaitable(*this);
+            return this->recycling([this, &sender] { return ::std::forward<Sender>(sender).as_awaitable(*this); });
         } else {
-            return ::beman::execution::as_awaitable(
-                ::beman::task::affine_on(::std::forward<Sender>(sender), this->get_scheduler()), *this);
+            // a skipped reschedule resumes inline, any other ends the inline resumptions
+            auto skip{[this](bool possible) noexcept {
+                if (possible) {
+                    return this->consume_inline_resumption();
+                }
+                this->reset_inline_resumptions();
+                return false;
+            }};
+            if constexpr (report_error_codes) {
+                return this->recycling([this, &sender, skip] {
+                    return ::beman::execution::as_awaitable(
+                        ::beman::task::detail::forward_error_codes(
+                            ::beman::task::affine_on(::std::forward<Sender>(sender), this->get_scheduler(), skip),
+                            *this),
+                        *this);
+                });
+            } else {
+                return this->recycling([this, &sender, skip] {
+                    return ::beman::execution::as_awaitable(
+                        ::beman::task::affine_on(::std::forward<Sender>(sender), this->get_scheduler(), skip), *this);
+                });
+            }
         }
     }
     auto await_transform(::beman::task::detail::change_coroutine_scheduler<scheduler_type> c) {
         return ::std::move(c);
     }
+    auto await_transform(::beman::task::detail::yield_t::request) {
+        this->reset_inline_resumptions();
+        return this->recycling([this] {
+            return ::beman::execution::as_awaitable(::beman::execution::schedule(this->get_scheduler()), *this);
+        });
+    }
+
+    /*
+     * \brief Determine whether the coroutine can be resumed inline.
+     *
+     * The function is called when an awaited task completed on the
+     * coroutine's scheduler or when an awaited sender's reschedule can be
+     * skipped because it completes on that scheduler. It returns `false`
+     * once the context's `resumption_budget` of consecutive inline
+     * resumptions is used up in which case the coroutine should be
+     * rescheduled.
+     */
+    auto consume_inline_resumption() noexcept -> bool {
+        if constexpr (resumption_budget != 0u) {
+            if (resumption_budget <= ++this->inline_resumptions) {
+                this->inline_resumptions = 0u;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * \brief Complete the coroutine with an error of an awaited task.
+     *
+     * The function is only available if the context opts into
+     * `forward_errors` and `E` is one of the coroutine's error types or if
+     * the context opts into `report_error_codes` and `E` can be
+     * represented as `std::error_code`. It returns the coroutine to resume
+     * next.
+     */
+    template <typename E>
+        requires(::beman::task::detail::forward_errors_of_v<Environment> &&
+                 ::beman::task::detail::meta::list_contains_v<error_types, ::beman::execution::set_error_t(E)>) ||
+                (report_error_codes && ::beman::task::detail::maps_to_error_code<E>)
+    auto forward_error(E&& error) -> ::std::coroutine_handle<> {
+        if constexpr (::beman::task::detail::meta::list_contains_v<error_types, ::beman::execution::set_error_t(E)>) {
+            this->get_state()->set_error(::std::move(error));
+        } else {
+            this->get_state()->set_error(::beman::task::detail::to_error_code(error));
+        }
+        return this->get_state()->complete();
+    }
 
     template <typename E>
     auto yield_value(with_error<E> with) noexcept -> ::beman::task::detail::final_awaiter {
+        this->stop_recycling();
         this->get_state()->set_error(::std::move(with.error));
         return {};
     }
@@ -110,9 +207,44 @@ class promise_type
 
   private:
     using env_t = ::beman::task::detail::promise_env<promise_type>;
+    struct no_frame_cache {};
+    struct no_resumption_count {};
+
+    auto reset_inline_resumptions() noexcept -> void {
+        if constexpr (resumption_budget != 0u) {
+            this->inline_resumptions = 0u;
+        }
+    }
+
+    /*
+     * \brief Make the frame cache current while the coroutine runs.
+     *
+     * If the context opts into `recycle_frames`, the awaitable created by
+     * `make` is wrapped to reset the current `frame_cache` when the
+     * coroutine suspends and to make the coroutine's cache current when it
+     * is resumed. The awaitable is created in place as it may not be
+     * movable.
+     */
+    template <typename Make>
+    auto recycling(Make make) noexcept {
+        if constexpr (recycle_frames) {
+            return ::beman::task::detail::frame_cache_awaitable<::std::invoke_result_t<Make&>>{&this->cache, make()};
+        } else {
+            return make();
+        }
+    }
+    auto stop_recycling() noexcept -> void {
+        if constexpr (recycle_frames) {
+            ::beman::task::detail::frame_cache::leave();
+        }
+    }
 
     allocator_type                  allocator{};
     ::std::optional<scheduler_type> scheduler{};
+    [[no_unique_address]] ::std::conditional_t<resumption_budget != 0u, ::std::size_t, no_resumption_count>
+        inline_resumptions{};
+    [[no_unique_address]] ::std::conditional_t<recycle_frames, ::beman::task::detail::frame_cache, no_frame_cache>
+        cache;
 };
 } // namespace beman::task::detail
 
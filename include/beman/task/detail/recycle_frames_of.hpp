@@ -0,0 +1,43 @@
+// include/beman/task/detail/recycle_frames_of.hpp                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RECYCLE_FRAMES_OF
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RECYCLE_FRAMES_OF
+
+#include <concepts>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Utility to determine whether a coroutine recycles the frames of awaited tasks
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A context can define a `static constexpr bool recycle_frames`. If it
+ * is `true`, a task using this context keeps the memory of the frame of
+ * the last task it `co_await`ed in a one-slot `frame_cache` and uses it
+ * for the next task whose frame has the same size and uses an equal
+ * allocator, e.g., when awaiting tasks in a loop. The memory is released
+ * when the coroutine is destroyed. Only the frames of tasks whose context
+ * also sets `recycle_frames` are recycled: the allocation of other tasks
+ * doesn't look for a current `frame_cache`. The default is `false`.
+ */
+template <typename>
+struct recycle_frames_of {
+    static constexpr bool value{false};
+};
+template <typename Context>
+    requires requires {
+        { Context::recycle_frames } -> std::convertible_to<bool>;
+    }
+struct recycle_frames_of<Context> {
+    static constexpr bool value{Context::recycle_frames};
+};
+template <typename Context>
+inline constexpr bool recycle_frames_of_v{recycle_frames_of<Context>::value};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
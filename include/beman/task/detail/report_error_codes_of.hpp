@@ -0,0 +1,45 @@
+// include/beman/task/detail/report_error_codes_of.hpp                -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_REPORT_ERROR_CODES_OF
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_REPORT_ERROR_CODES_OF
+
+#include <concepts>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Utility to determine whether a context reports errors as `std::error_code`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A context can define a `static constexpr bool report_error_codes`. If
+ * it is `true`, the default error types of a task using this context
+ * contain `set_error_t(std::error_code)` in addition to
+ * `set_error_t(std::exception_ptr)`. When the coroutine `co_await`s a
+ * sender or a task completing with an error which can be represented as
+ * `std::error_code` (e.g., `std::errc::connection_reset`) the coroutine
+ * completes with this error code instead of getting an exception thrown:
+ * reporting the error neither allocates nor throws. This applies to
+ * errors of the scheduler used to resume the coroutine, too. The default
+ * is `false`.
+ */
+template <typename>
+struct report_error_codes_of {
+    static constexpr bool value{false};
+};
+template <typename Context>
+    requires requires {
+        { Context::report_error_codes } -> std::convertible_to<bool>;
+    }
+struct report_error_codes_of<Context> {
+    static constexpr bool value{Context::report_error_codes};
+};
+template <typename Context>
+inline constexpr bool report_error_codes_of_v{report_error_codes_of<Context>::value};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -4,6 +4,7 @@
 #ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESULT_TYPE
 #define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESULT_TYPE
 
+#include <beman/task/detail/exceptions.hpp>
 #include <beman/task/detail/sub_visit.hpp>
 #include <beman/execution/execution.hpp>
 #include <exception>
@@ -107,6 +108,28 @@ class result_type<Stop, Value, ::beman::execution::completion_signatures<::beman
             break;
         }
     }
+    /**
+     * \brief Pass an error result to `fun` instead of throwing it.
+     *
+     * If the result is an error other than `std::exception_ptr` and `fun` can
+     * be called with it, `fun` is called with the moved error and `true` is
+     * returned. Otherwise, `false` is returned and the result is unchanged.
+     */
+    template <typename Fun>
+    auto result_forward_error(Fun&& fun) -> bool {
+        bool forwarded{false};
+        if constexpr (0u < sizeof...(Error))
+            ::beman::task::detail::sub_visit<2u>(
+                [&fun, &forwarded]<typename E>(E& error) {
+                    if constexpr (not ::std::same_as<E, ::std::exception_ptr> &&
+                                  requires { fun(::std::move(error)); }) {
+                        fun(::std::move(error));
+                        forwarded = true;
+                    }
+                },
+                this->result);
+        return forwarded;
+    }
     auto result_resume() {
         switch (this->result.index()) {
         case 0:
@@ -119,9 +142,9 @@ class result_type<Stop, Value, ::beman::execution::completion_signatures<::beman
                 ::beman::task::detail::sub_visit<2u>(
                     []<typename E>(E& error) {
                         if constexpr (::std::same_as<::std::remove_cvref_t<E>, ::std::exception_ptr>)
-                            std::rethrow_exception(::std::move(error));
+                            ::beman::task::detail::rethrow_exception(::std::move(error));
                         else
-                            throw ::std::move(error);
+                            ::beman::task::detail::throw_exception(::std::move(error));
                     },
                     this->result);
             std::terminate(); // should never come here!
@@ -132,6 +155,84 @@ class result_type<Stop, Value, ::beman::execution::completion_signatures<::beman
         else
             return ::std::move(::std::get<1u>(this->result));
     }
+    /**
+     * \brief Produce the result as a reference to the stored value.
+     *
+     * This function behaves like `result_resume()` except that a value is
+     * returned as rvalue reference to the stored result instead of being
+     * moved out of it.
+     */
+    auto result_resume_reference() -> decltype(auto) {
+        if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+            return this->result_resume();
+        else {
+            if (this->result.index() != 1u)
+                this->result_resume(); // throws the error or terminates
+            return static_cast<value_type&&>(::std::get<1u>(this->result));
+        }
+    }
+
+    /**
+     * \brief Call the completion function without consuming the result.
+     *
+     * This function behaves like `result_complete()` except that the
+     * result is passed as `const` lvalue and stays in place, i.e., the
+     * same result can be used to complete multiple receivers.
+     */
+    template <::beman::execution::receiver Receiver>
+    auto result_complete_shared(Receiver&& rcvr) const -> void {
+        switch (this->result.index()) {
+        case 0:
+            if constexpr (Stop == ::beman::task::detail::stoppable::yes)
+                ::beman::execution::set_stopped(::std::move(rcvr));
+            else
+                ::std::terminate();
+            break;
+        case 1:
+            if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+                ::beman::execution::set_value(::std::move(rcvr));
+            else
+                ::beman::execution::set_value(::std::move(rcvr), ::std::get<1u>(this->result));
+            break;
+        default:
+            if constexpr (0u < sizeof...(Error))
+                ::beman::task::detail::sub_visit<2u>(
+                    [&rcvr](const auto& error) { ::beman::execution::set_error(::std::move(rcvr), error); },
+                    this->result);
+            break;
+        }
+    }
+    /**
+     * \brief Produce the result without consuming it.
+     *
+     * Errors are thrown as copies and a value is returned as `const`
+     * lvalue reference to the stored result.
+     */
+    auto result_resume_shared() const -> decltype(auto) {
+        switch (this->result.index()) {
+        case 0:
+            std::terminate(); // should never come here!
+            break;
+        case 1:
+            break;
+        default:
+            if constexpr (0u < sizeof...(Error))
+                ::beman::task::detail::sub_visit<2u>(
+                    []<typename E>(const E& error) {
+                        if constexpr (::std::same_as<::std::remove_cvref_t<E>, ::std::exception_ptr>)
+                            ::beman::task::detail::rethrow_exception(error);
+                        else
+                            ::beman::task::detail::throw_exception(error);
+                    },
+                    this->result);
+            std::terminate(); // should never come here!
+            break;
+        }
+        if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+            return;
+        else
+            return ::std::get<1u>(this->result);
+    }
 };
 template <::beman::task::detail::stoppable Stop, typename Value>
 class result_type<Stop, Value, ::beman::execution::completion_signatures<>> {
@@ -194,6 +295,10 @@ class result_type<Stop, Value, ::beman::execution::completion_signatures<>> {
             break;
         }
     }
+    template <typename Fun>
+    auto result_forward_error(Fun&&) -> bool {
+        return false;
+    }
     auto result_resume() {
         switch (this->result.index()) {
         case 0:
@@ -210,6 +315,57 @@ class result_type<Stop, Value, ::beman::execution::completion_signatures<>> {
         else
             return ::std::move(::std::get<1u>(this->result));
     }
+    /**
+     * \brief Produce the result as a reference to the stored value.
+     *
+     * This function behaves like `result_resume()` except that a value is
+     * returned as rvalue reference to the stored result instead of being
+     * moved out of it.
+     */
+    auto result_resume_reference() -> decltype(auto) {
+        if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+            return this->result_resume();
+        else {
+            if (this->result.index() != 1u)
+                this->result_resume(); // throws the error or terminates
+            return static_cast<value_type&&>(::std::get<1u>(this->result));
+        }
+    }
+
+    /**
+     * \brief Call the completion function without consuming the result.
+     */
+    template <::beman::execution::receiver Receiver>
+    auto result_complete_shared(Receiver&& rcvr) const -> void {
+        switch (this->result.index()) {
+        case 0:
+            if constexpr (Stop == ::beman::task::detail::stoppable::yes)
+                ::beman::execution::set_stopped(::std::move(rcvr));
+            else
+                ::std::terminate();
+            break;
+        case 1:
+            if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+                ::beman::execution::set_value(::std::move(rcvr));
+            else
+                ::beman::execution::set_value(::std::move(rcvr), ::std::get<1u>(this->result));
+            break;
+        default:
+            std::terminate(); // should never come here!
+            break;
+        }
+    }
+    /**
+     * \brief Produce the result without consuming it.
+     */
+    auto result_resume_shared() const -> decltype(auto) {
+        if (this->result.index() != 1u)
+            std::terminate(); // should never come here!
+        if constexpr (::std::same_as<::beman::task::detail::void_type, value_type>)
+            return;
+        else
+            return ::std::get<1u>(this->result);
+    }
 };
 } // namespace beman::task::detail
 
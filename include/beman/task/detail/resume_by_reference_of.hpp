@@ -0,0 +1,50 @@
+// include/beman/task/detail/resume_by_reference_of.hpp               -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESUME_BY_REFERENCE_OF
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESUME_BY_REFERENCE_OF
+
+#include <concepts>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Utility to determine whether awaiting a task yields a reference to its result
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A context can define a `static constexpr bool resume_by_reference`. If
+ * it is `true`, `co_await`ing a task using this context produces an
+ * rvalue reference to the result object constructed by `co_return`
+ * instead of a value moved out of it. The default is `false`.
+ *
+ * The result object is stored in the awaiter and is destroyed at the end
+ * of the full expression containing the `co_await`. Within this
+ * expression the value can be consumed without a move, e.g.,
+ * `process(co_await parse(input))`. A variable initialised from the
+ * expression, e.g., `auto value = co_await parse(input);`, holds its own
+ * value moved out of the result object, i.e., the opt-in only avoids the
+ * move when the value is consumed in place. A reference
+ * bound to the expression, e.g., `auto&& value = co_await parse(input);`
+ * or `const T& value = co_await parse(input);`, dangles after the full
+ * expression: the lifetime of the result object isn't extended.
+ */
+template <typename>
+struct resume_by_reference_of {
+    static constexpr bool value{false};
+};
+template <typename Context>
+    requires requires {
+        { Context::resume_by_reference } -> std::convertible_to<bool>;
+    }
+struct resume_by_reference_of<Context> {
+    static constexpr bool value{Context::resume_by_reference};
+};
+template <typename Context>
+inline constexpr bool resume_by_reference_of_v{resume_by_reference_of<Context>::value};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
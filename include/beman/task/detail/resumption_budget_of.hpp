@@ -0,0 +1,42 @@
+// include/beman/task/detail/resumption_budget_of.hpp                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESUMPTION_BUDGET_OF
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_RESUMPTION_BUDGET_OF
+
+#include <concepts>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Utility to get the budget of inline resumptions from a context
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ *
+ * A context can define a `static constexpr std::size_t resumption_budget`.
+ * If it is non-zero, a coroutine using this context is resumed inline at
+ * most `resumption_budget` consecutive times when an awaited task
+ * completes on the coroutine's scheduler: after that the coroutine is
+ * rescheduled on its scheduler, giving other work a chance to run. The
+ * default is `0`, i.e., the coroutine is always resumed inline.
+ */
+template <typename>
+struct resumption_budget_of {
+    static constexpr ::std::size_t value{0u};
+};
+template <typename Context>
+    requires requires {
+        { Context::resumption_budget } -> std::convertible_to<::std::size_t>;
+    }
+struct resumption_budget_of<Context> {
+    static constexpr ::std::size_t value{Context::resumption_budget};
+};
+template <typename Context>
+inline constexpr ::std::size_t resumption_budget_of_v{resumption_budget_of<Context>::value};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
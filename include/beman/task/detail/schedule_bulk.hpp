@@ -0,0 +1,51 @@
+// include/beman/task/detail/schedule_bulk.hpp                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SCHEDULE_BULK
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SCHEDULE_BULK
+
+#include <beman/execution/execution.hpp>
+#include <cstddef>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Customization point object running a function for many indices on a scheduler
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * The sender `schedule_bulk(sched, count, fn)` calls `fn(i)` for each `i`
+ * in `[0, count)` on execution agents of `sched` and completes with
+ * `set_value()` once all calls returned. If `sched` has a member
+ * `schedule_bulk(count, fn)`, the submission is delegated to it. Such a
+ * scheduler can submit all work at once, e.g., taking its lock and
+ * waking its threads only once. Otherwise, the work is submitted as a
+ * single item using `schedule(sched)` which runs all calls sequentially.
+ *
+ * Usage:
+ *
+ *     co_await schedule_bulk(sched, items.size(), [&](std::size_t i) { process(items[i]); });
+ */
+struct schedule_bulk_t {
+    template <::beman::execution::scheduler Scheduler, typename Fn>
+    auto operator()(Scheduler&& sched, ::std::size_t count, Fn&& fn) const {
+        if constexpr (requires { sched.schedule_bulk(count, ::std::forward<Fn>(fn)); }) {
+            return sched.schedule_bulk(count, ::std::forward<Fn>(fn));
+        } else {
+            return ::beman::execution::then(::beman::execution::schedule(sched),
+                                            [count, f = ::std::forward<Fn>(fn)]() mutable {
+                                                for (::std::size_t i{}; i != count; ++i) {
+                                                    f(i);
+                                                }
+                                            });
+        }
+    }
+};
+
+inline constexpr schedule_bulk_t schedule_bulk{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
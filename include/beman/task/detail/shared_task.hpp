@@ -0,0 +1,245 @@
+// include/beman/task/detail/shared_task.hpp                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SHARED_TASK
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SHARED_TASK
+
+#include <beman/task/detail/task.hpp>
+#include <beman/task/detail/awaiter.hpp>
+#include <beman/task/detail/completion.hpp>
+#include <beman/task/detail/error_types_of.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/handle.hpp>
+#include <beman/task/detail/promise_type.hpp>
+#include <beman/task/detail/scheduler_of.hpp>
+#include <beman/task/detail/state_base.hpp>
+#include <beman/task/detail/stop_source.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/detail/meta_combine.hpp>
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Node used to subscribe to the completion of a `shared_task`.
+ * \headerfile beman/task/shared_task.hpp <beman/task/shared_task.hpp>
+ * \internal
+ */
+struct shared_waiter {
+    shared_waiter* next{};
+    virtual auto   complete() noexcept -> void = 0;
+
+  protected:
+    ~shared_waiter() = default;
+};
+
+/*!
+ * \brief State shared between all copies of a `shared_task`.
+ * \headerfile beman/task/shared_task.hpp <beman/task/shared_task.hpp>
+ * \internal
+ *
+ * The coroutine is started by the first subscriber. Subscribers are kept
+ * in an intrusive lock-free list which is also used to represent the
+ * state of the computation:
+ * - `not_started()`: the coroutine was not started, yet.
+ * - `nullptr`: the coroutine is running and there are no subscribers.
+ * - `completed()`: the result is available.
+ * - any other value: the head of the list of subscribers.
+ */
+template <typename Promise, typename Value, typename Env>
+class shared_state : public ::beman::task::detail::state_base<Value, Env> {
+  public:
+    using stop_source_type = ::beman::task::detail::stop_source_of_t<Env>;
+    using stop_token_type  = decltype(std::declval<stop_source_type>().get_token());
+    using scheduler_type   = ::beman::task::detail::scheduler_of_t<Env>;
+
+    explicit shared_state(::beman::task::detail::handle<Promise> h) : handle(::std::move(h)) {}
+
+    auto is_complete() const noexcept -> bool {
+        return this->waiters.load(::std::memory_order_acquire) == this->completed();
+    }
+
+    /*
+     * \brief Subscribe to the completion, starting the coroutine if needed.
+     *
+     * The scheduler of the coroutine is obtained from the environment of
+     * the first subscriber. The function returns `false` if the result is
+     * already available in which case `waiter` isn't enqueued.
+     */
+    template <typename E>
+    auto subscribe(::beman::task::detail::shared_waiter* waiter, const E& env) -> bool {
+        void* head{this->waiters.load(::std::memory_order_acquire)};
+        if (head == this->not_started() &&
+            this->waiters.compare_exchange_strong(head, nullptr, ::std::memory_order_acq_rel)) {
+            this->scheduler.emplace(this->template from_env<scheduler_type>(env));
+            this->handle.start(this).resume();
+            head = this->waiters.load(::std::memory_order_acquire);
+        }
+        do {
+            if (head == this->completed()) {
+                return false;
+            }
+            waiter->next = static_cast<::beman::task::detail::shared_waiter*>(head);
+        } while (not this->waiters.compare_exchange_weak(
+            head, waiter, ::std::memory_order_release, ::std::memory_order_acquire));
+        return true;
+    }
+
+  private:
+    auto not_started() const noexcept -> void* { return const_cast<void*>(static_cast<const void*>(&this->waiters)); }
+    auto completed() const noexcept -> void* { return const_cast<void*>(static_cast<const void*>(this)); }
+
+    auto do_complete() -> std::coroutine_handle<> override {
+        void* head{this->waiters.exchange(this->completed(), ::std::memory_order_acq_rel)};
+        // Completing a waiter may release the last reference to this
+        // object: only local variables are used after the first completion.
+        for (auto* waiter{static_cast<::beman::task::detail::shared_waiter*>(head)}; waiter != nullptr;) {
+            ::std::exchange(waiter, waiter->next)->complete();
+        }
+        return ::std::noop_coroutine();
+    }
+    auto do_get_scheduler() -> scheduler_type override { return *this->scheduler; }
+    auto do_set_scheduler(scheduler_type other) -> scheduler_type override {
+        return ::std::exchange(*this->scheduler, other);
+    }
+    auto do_get_stop_token() -> stop_token_type override { return this->source.get_token(); }
+    auto do_get_environment() -> Env& override { return this->env; }
+
+    ::beman::task::detail::handle<Promise> handle;
+    stop_source_type                       source;
+    Env                                    env{};
+    ::std::optional<scheduler_type>        scheduler;
+    ::std::atomic<void*>                   waiters{this->not_started()};
+};
+
+/*!
+ * \brief Coroutine type whose result is computed once and shared
+ * \headerfile beman/task/shared_task.hpp <beman/task/shared_task.hpp>
+ *
+ * A `shared_task<T, C>` is a coroutine like `task<T, C>` except that
+ * objects can be copied and awaited any number of times. The coroutine is
+ * started when the first copy is awaited (or `connect`ed and `start`ed)
+ * and all awaiters get access to the same result. The scheduler used
+ * to run the coroutine is obtained from the first awaiter.
+ *
+ * When `co_await`ed from a `task` the result is produced as
+ * `const T&` referring to the stored result and the awaiting task resumes
+ * on its own scheduler. When used as a sender, `set_value` is called with
+ * a `const T&`. Errors are copied.
+ *
+ * Usage:
+ *
+ *     shared_task<config> load() { co_return co_await read_config(); }
+ *     auto cfg{load()};
+ *     co_await when_all(use(cfg), use(cfg));
+ */
+template <typename Value = void, typename Env = ::beman::task::detail::default_environment>
+class shared_task {
+  public:
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::detail::meta::combine<
+        ::beman::execution::completion_signatures<::beman::task::detail::shared_completion_t<Value>,
+                                                  ::beman::execution::set_stopped_t()>,
+        ::beman::task::detail::error_types_of_t<Env> >;
+
+    using promise_type = ::beman::task::detail::promise_type<shared_task, Value, Env>;
+
+  private:
+    using state_type = ::beman::task::detail::shared_state<promise_type, Value, Env>;
+
+    template <typename Receiver>
+    struct state : ::beman::task::detail::shared_waiter {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+
+        ::std::shared_ptr<state_type> shared;
+        ::std::remove_cvref_t<Receiver> receiver;
+
+        template <typename R>
+        state(::std::shared_ptr<state_type> s, R&& r) : shared(::std::move(s)), receiver(::std::forward<R>(r)) {}
+        auto start() & noexcept -> void {
+            if (not this->shared->subscribe(this, ::beman::execution::get_env(this->receiver))) {
+                this->complete();
+            }
+        }
+        auto complete() noexcept -> void override {
+            this->shared->result_complete_shared(::std::move(this->receiver));
+        }
+    };
+
+    template <typename ParentPromise>
+    class awaiter : public ::beman::task::detail::shared_waiter {
+      public:
+        explicit awaiter(::std::shared_ptr<state_type> s) : shared(::std::move(s)) {}
+        auto await_ready() const noexcept -> bool { return this->shared->is_complete(); }
+        auto await_suspend(::std::coroutine_handle<ParentPromise> p) -> bool {
+            this->parent = p;
+            return this->shared->subscribe(this, ::beman::execution::get_env(this->parent.promise()));
+        }
+        auto await_resume() -> decltype(auto) { return this->shared->result_resume_shared(); }
+
+      private:
+        friend struct ::beman::task::detail::awaiter_scheduler_receiver<awaiter>;
+        auto complete() noexcept -> void override {
+            auto& promise{this->parent.promise()};
+            if constexpr (requires {
+                              this->shared->get_scheduler() !=
+                                  ::beman::execution::get_scheduler(::beman::execution::get_env(promise));
+                          }) {
+                if (this->shared->get_scheduler() !=
+                    ::beman::execution::get_scheduler(::beman::execution::get_env(promise))) {
+                    this->reschedule.emplace(promise, this);
+                    this->reschedule->start();
+                    return;
+                }
+            }
+            this->actual_complete().resume();
+        }
+        auto actual_complete() -> std::coroutine_handle<> {
+            return this->shared->no_completion_set() ? this->parent.promise().unhandled_stopped() : this->parent;
+        }
+
+        ::std::shared_ptr<state_type>                                               shared;
+        ::std::coroutine_handle<ParentPromise>                                      parent{};
+        ::std::optional<::beman::task::detail::awaiter_op_t<awaiter, ParentPromise>> reschedule{};
+    };
+
+    ::std::shared_ptr<state_type> shared;
+
+    friend promise_type;
+    explicit shared_task(::beman::task::detail::handle<promise_type> h)
+        : shared(shared_task::make_state(::std::move(h))) {}
+
+    // Called from get_return_object(): if allocating the state fails, the
+    // exception propagates to the caller of the coroutine which also
+    // destroys the coroutine frame. Thus, the frame needs to be released.
+    static auto make_state(::beman::task::detail::handle<promise_type>&& h) -> ::std::shared_ptr<state_type> {
+        BEMAN_TASK_TRY { return ::std::make_shared<state_type>(::std::move(h)); }
+        BEMAN_TASK_CATCH_ALL {
+            static_cast<void>(h.release());
+            ::beman::task::detail::rethrow();
+        }
+    }
+
+  public:
+    using task_concept = void;
+
+    template <typename Receiver>
+    auto connect(Receiver&& receiver) const -> state<Receiver> {
+        return state<Receiver>(this->shared, ::std::forward<Receiver>(receiver));
+    }
+    template <typename ParentPromise>
+    auto as_awaitable(ParentPromise&) const -> awaiter<ParentPromise> {
+        return awaiter<ParentPromise>(this->shared);
+    }
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
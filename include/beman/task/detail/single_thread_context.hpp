@@ -4,6 +4,7 @@
 #ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SINGLE_THREAD_CONTEXT
 #define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_SINGLE_THREAD_CONTEXT
 
+#include <beman/task/detail/wakeup_loop.hpp>
 #include <beman/execution/execution.hpp>
 #include <thread>
 
@@ -12,8 +13,13 @@
 namespace beman::task::detail {
 class single_thread_context {
   private:
-    ::beman::execution::run_loop loop;
-    ::std::thread                thread{[this] { this->loop.run(); }};
+#ifdef BEMAN_TASK_HAS_EVENTFD
+    using loop_t = ::beman::task::detail::wakeup_loop;
+#else
+    using loop_t = ::beman::execution::run_loop;
+#endif
+    loop_t        loop;
+    ::std::thread thread{[this] { this->loop.run(); }};
 
   public:
     single_thread_context() = default;
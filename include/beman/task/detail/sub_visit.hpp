@@ -36,6 +36,12 @@ void sub_visit(auto&& fun, std::variant<T...>& v) {
         return;
     sub_visit_thunks<Start>(fun, v, std::make_index_sequence<sizeof...(T) - Start>{});
 }
+template <std::size_t Start, typename... T>
+void sub_visit(auto&& fun, const std::variant<T...>& v) {
+    if (v.index() < Start)
+        return;
+    sub_visit_thunks<Start>(fun, v, std::make_index_sequence<sizeof...(T) - Start>{});
+}
 
 } // namespace beman::task::detail
 
@@ -30,6 +30,20 @@
 #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
 #endif
 
+// A task which is immediately co_await'ed from another task can't outlive
+// the awaiting coroutine: the awaiter owns the task's frame and destroys it
+// at the end of the co_await expression. Compilers supporting
+// [[clang::coro_await_elidable]] can thus place such a frame into the frame
+// of the awaiting coroutine instead of allocating it.
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::coro_await_elidable)
+#define BEMAN_TASK_CORO_AWAIT_ELIDABLE [[clang::coro_await_elidable]]
+#endif
+#endif
+#ifndef BEMAN_TASK_CORO_AWAIT_ELIDABLE
+#define BEMAN_TASK_CORO_AWAIT_ELIDABLE
+#endif
+
 // ----------------------------------------------------------------------------
 
 namespace beman::task::detail {
@@ -37,7 +51,7 @@ namespace beman::task::detail {
 struct default_environment {};
 
 template <typename Value = void, typename Env = default_environment>
-class task {
+class BEMAN_TASK_CORO_AWAIT_ELIDABLE task {
   private:
     using stop_source_type = ::beman::task::detail::stop_source_of_t<Env>;
     using stop_token_type  = decltype(std::declval<stop_source_type>().get_token());
@@ -59,7 +73,7 @@ class task {
 
   private:
     friend promise_type;
-    explicit task(::beman::task::detail::handle<promise_type> h) : handle(std::move(h)) {}
+    explicit task(::beman::task::detail::handle<promise_type> h) noexcept : handle(std::move(h)) {}
 
   public:
     using task_concept               = void;
@@ -74,8 +88,10 @@ class task {
         return state<Receiver>(std::forward<Receiver>(receiver), std::move(this->handle));
     }
     template <typename ParentPromise>
-    auto as_awaitable(ParentPromise&) -> ::beman::task::detail::awaiter<Value, Env, promise_type, ParentPromise> {
-        return ::beman::task::detail::awaiter<Value, Env, promise_type, ParentPromise>(::std::move(this->handle));
+    auto as_awaitable(ParentPromise& parent)
+        -> ::beman::task::detail::awaiter<Value, Env, promise_type, ParentPromise> {
+        return ::beman::task::detail::awaiter<Value, Env, promise_type, ParentPromise>(
+            ::std::move(this->handle), ::beman::execution::get_env(parent));
     }
 };
 } // namespace beman::task::detail
@@ -5,9 +5,20 @@
 #define INCLUDED_BEMAN_TASK_DETAIL_task_scheduler
 
 #include <beman/execution/execution.hpp>
+#include <beman/task/detail/error_code.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/get_deadline.hpp>
+#include <beman/task/detail/get_priority.hpp>
 #include <beman/task/detail/poly.hpp>
+#include <beman/task/detail/schedule_bulk.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
 #include <new>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 // ----------------------------------------------------------------------------
@@ -20,9 +31,30 @@ namespace beman::task::detail {
  *
  * The class `task_scheduler` is used to type-erase any scheduler class.
  * Any error produced by the underlying scheduler except `std::error_code` is turned into
- * an `std::exception_ptr`. `std::error_code` is forwarded as is. The `task_scheduler`
+ * an `std::exception_ptr`. `std::error_code` is forwarded as is and errors which can be
+ * represented as `std::error_code`, e.g., `std::errc`, are converted to `std::error_code`
+ * without allocating. The `task_scheduler`
  * forwards stop requests reported by the stop token obtained from the `connect`ed
- * receiver to the sender used by the underlying scheduler.
+ * receiver to the sender used by the underlying scheduler. The forwarding
+ * queries `get_priority` and `get_deadline` of the receiver's environment
+ * are also answered for the underlying scheduler, e.g., a task's
+ * continuation keeps the task's lane on a `priority_scheduler` and its
+ * deadline on an `edf_scheduler`.
+ *
+ * The member `schedule_bulk(count, fn)` forwards to the member
+ * `schedule_bulk` of the underlying scheduler if it has one, i.e., fanning
+ * out `count` calls costs one type-erased operation and one submission.
+ * Otherwise, all calls are made sequentially on one execution agent
+ * obtained with the underlying scheduler's `schedule()`; this fallback is
+ * not instantiated per scheduler. An exception thrown by `fn` is reported
+ * as `std::exception_ptr` after all calls returned.
+ *
+ * The operation state of the underlying scheduler's sender is embedded
+ * into the `task_scheduler`'s operation state if it is small enough and
+ * allocated otherwise.
+ *
+ * In builds without exceptions there is no `std::exception_ptr` completion:
+ * errors other than `std::error_code` are reported using `unhandled_failure()`.
  *
  * Completion signatures:
  *
@@ -39,11 +71,15 @@ namespace beman::task::detail {
 class task_scheduler {
     struct state_base {
         virtual ~state_base()                                                               = default;
-        virtual void                                   complete_value()                     = 0;
-        virtual void                                   complete_error(::std::error_code)    = 0;
-        virtual void                                   complete_error(::std::exception_ptr) = 0;
-        virtual void                                   complete_stopped()                   = 0;
-        virtual ::beman::execution::inplace_stop_token get_stop_token()                     = 0;
+        virtual void                                    complete_value()                    = 0;
+        virtual void                                    complete_error(::std::error_code)   = 0;
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+        virtual void complete_error(::std::exception_ptr) = 0;
+#endif
+        virtual void                                    complete_stopped()                  = 0;
+        virtual ::beman::execution::inplace_stop_token  get_stop_token()                    = 0;
+        virtual ::std::optional<::std::size_t>          priority()                          = 0;
+        virtual ::std::chrono::steady_clock::time_point deadline()                          = 0;
     };
 
     struct inner_state {
@@ -51,17 +87,35 @@ class task_scheduler {
         struct env {
             state_base* state;
             auto query(::beman::execution::get_stop_token_t) const noexcept { return this->state->get_stop_token(); }
+            auto query(const ::beman::task::detail::get_priority_t&) const noexcept -> ::std::optional<::std::size_t> {
+                return this->state->priority();
+            }
+            auto query(const ::beman::task::detail::get_deadline_t&) const noexcept
+                -> ::std::chrono::steady_clock::time_point {
+                return this->state->deadline();
+            }
         };
         struct receiver {
             using receiver_concept = ::beman::execution::receiver_t;
             state_base* state;
             void        set_value() && noexcept { this->state->complete_value(); }
             void        set_error(std::error_code err) && noexcept { this->state->complete_error(err); }
-            void        set_error(std::exception_ptr ptr) && noexcept { this->state->complete_error(std::move(ptr)); }
+            template <::beman::task::detail::maps_to_error_code E>
+            void set_error(E e) && noexcept {
+                this->state->complete_error(::beman::task::detail::to_error_code(e));
+            }
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+            void set_error(std::exception_ptr ptr) && noexcept { this->state->complete_error(std::move(ptr)); }
             template <typename E>
             void set_error(E e) && noexcept {
                 this->state->complete_error(std::make_exception_ptr(std::move(e)));
             }
+#else
+            template <typename E>
+            void set_error(E) && noexcept {
+                ::beman::task::detail::unhandled_failure();
+            }
+#endif
             void set_stopped() && noexcept { this->state->complete_stopped(); }
             env  get_env() const noexcept { return {this->state}; }
         };
@@ -79,9 +133,24 @@ class task_scheduler {
             concrete(S&& s, state_base* b) : state(::beman::execution::connect(std::forward<S>(s), receiver{b})) {}
             void start() override { ::beman::execution::start(state); }
         };
-        ::beman::task::detail::poly<base, 16u * sizeof(void*)> state;
+        // Operation states not fitting into the buffer are allocated.
+        template <::beman::execution::sender Sender>
+        struct boxed : base {
+            ::std::unique_ptr<concrete<Sender>> op;
+            template <::beman::execution::sender S>
+            boxed(S&& s, state_base* b) : op(new concrete<Sender>(std::forward<S>(s), b)) {}
+            void start() override { this->op->start(); }
+        };
+        static constexpr ::std::size_t size{16u * sizeof(void*)};
+        template <typename Sender>
+        static constexpr bool fits{sizeof(concrete<Sender>) <= size &&
+                                   alignof(concrete<Sender>) <= alignof(::beman::task::detail::poly<base, size>)};
+        template <typename Sender>
+        using impl_t = ::std::conditional_t<fits<Sender>, concrete<Sender>, boxed<Sender>>;
+
+        ::beman::task::detail::poly<base, size> state;
         template <::beman::execution::sender S>
-        inner_state(S&& s, state_base* b) : state(static_cast<concrete<S>*>(nullptr), std::forward<S>(s), b) {}
+        inner_state(S&& s, state_base* b) : state(static_cast<impl_t<S>*>(nullptr), std::forward<S>(s), b) {}
         void start() { this->state->start(); }
     };
 
@@ -105,14 +174,16 @@ class task_scheduler {
         ::beman::execution::inplace_stop_source source;
         ::std::optional<callback_t>             callback;
 
-        template <::beman::execution::receiver R, typename PS>
-        state(R&& r, PS& ps) : receiver(std::forward<R>(r)), s(ps->connect(this)) {}
+        template <::beman::execution::receiver R, typename Connect>
+        state(R&& r, Connect&& connect) : receiver(std::forward<R>(r)), s(connect(static_cast<state_base*>(this))) {}
         void start() & noexcept { this->s.start(); }
         void complete_value() override { ::beman::execution::set_value(std::move(this->receiver)); }
         void complete_error(std::error_code err) override { ::beman::execution::set_error(std::move(receiver), err); }
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
         void complete_error(std::exception_ptr ptr) override {
             ::beman::execution::set_error(std::move(receiver), std::move(ptr));
         }
+#endif
         void complete_stopped() override { ::beman::execution::set_stopped(std::move(this->receiver)); }
         ::beman::execution::inplace_stop_token get_stop_token() override {
             if constexpr (::std::same_as<token_t, ::beman::execution::inplace_stop_token>) {
@@ -128,6 +199,12 @@ class task_scheduler {
                 return this->source.get_token();
             }
         }
+        ::std::optional<::std::size_t> priority() override {
+            return ::beman::task::detail::priority_of(::beman::execution::get_env(this->receiver));
+        }
+        ::std::chrono::steady_clock::time_point deadline() override {
+            return ::beman::task::detail::deadline_of(::beman::execution::get_env(this->receiver));
+        }
     };
 
     class sender;
@@ -176,11 +253,18 @@ class task_scheduler {
 
       public:
         using sender_concept = ::beman::execution::sender_t;
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
         using completion_signatures =
             ::beman::execution::completion_signatures<::beman::execution::set_value_t(),
                                                       ::beman::execution::set_error_t(std::error_code),
                                                       ::beman::execution::set_error_t(std::exception_ptr),
                                                       ::beman::execution::set_stopped_t()>;
+#else
+        using completion_signatures =
+            ::beman::execution::completion_signatures<::beman::execution::set_value_t(),
+                                                      ::beman::execution::set_error_t(std::error_code),
+                                                      ::beman::execution::set_stopped_t()>;
+#endif
 
         template <::beman::execution::scheduler S>
         explicit sender(S&& s) : inner_sender(static_cast<concrete<S>*>(nullptr), std::forward<S>(s)) {}
@@ -189,19 +273,28 @@ class task_scheduler {
 
         template <::beman::execution::receiver R>
         state<R> connect(R&& r) {
-            return state<R>(std::forward<R>(r), this->inner_sender);
+            return state<R>(std::forward<R>(r), [this](state_base* b) { return this->inner_sender->connect(b); });
         }
 
         env get_env() const noexcept { return env(this); }
     };
 
+    // type-erased reference to the function of schedule_bulk
+    struct bulk_function {
+        void* object;
+        void (*call)(void*, ::std::size_t) noexcept;
+        void operator()(::std::size_t index) const noexcept { this->call(this->object, index); }
+    };
+
     // scheduler implementation
     struct base {
-        virtual ~base()                          = default;
-        virtual sender schedule()                = 0;
-        virtual base*  move(void* buffer)        = 0;
-        virtual base*  clone(void*) const        = 0;
-        virtual bool   equals(const base*) const = 0;
+        virtual ~base()                                                             = default;
+        virtual sender      schedule()                                              = 0;
+        virtual inner_state schedule_bulk(::std::size_t, bulk_function, state_base*) = 0;
+        virtual base*       move(void* buffer)                                      = 0;
+        virtual base*       clone(void*) const                                      = 0;
+        virtual bool        equals(const base*) const                               = 0;
+        virtual bool        native_bulk() const noexcept                            = 0;
     };
     template <::beman::execution::scheduler Scheduler>
     struct concrete : base {
@@ -209,17 +302,106 @@ class task_scheduler {
         template <typename S>
             requires ::beman::execution::scheduler<::std::remove_cvref_t<S>>
         explicit concrete(S&& s) : scheduler(std::forward<S>(s)) {}
-        sender schedule() override { return sender(this->scheduler); }
-        base*  move(void* buffer) override { return new (buffer) concrete(std::move(*this)); }
-        base*  clone(void* buffer) const override { return new (buffer) concrete(*this); }
-        bool   equals(const base* o) const override {
+        sender      schedule() override { return sender(this->scheduler); }
+        inner_state schedule_bulk(::std::size_t count, bulk_function fn, state_base* b) override {
+            if constexpr (requires(Scheduler& s) { s.schedule_bulk(count, fn); }) {
+                return inner_state(this->scheduler.schedule_bulk(count, fn), b);
+            } else {
+                // Only the execution agent is obtained: bulk_state runs the calls sequentially.
+                return inner_state(::beman::execution::schedule(this->scheduler), b);
+            }
+        }
+        base* move(void* buffer) override { return new (buffer) concrete(std::move(*this)); }
+        base* clone(void* buffer) const override { return new (buffer) concrete(*this); }
+        bool  equals(const base* o) const override {
             auto other{dynamic_cast<const concrete*>(o)};
             return other ? this->scheduler == other->scheduler : false;
         }
+        bool native_bulk() const noexcept override {
+            return requires(Scheduler& s, bulk_function fn) { s.schedule_bulk(::std::size_t(), fn); };
+        }
     };
 
     poly<base, 4 * sizeof(void*)> scheduler;
 
+    template <::beman::execution::receiver Receiver, typename Fn>
+    struct bulk_state {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        struct receiver {
+            using receiver_concept = ::beman::execution::receiver_t;
+            bulk_state* st;
+            void        set_value() && noexcept {
+                for (::std::size_t i{}; i != this->st->serial; ++i) {
+                    bulk_state::call(this->st, i);
+                }
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+                if (this->st->failed.load(::std::memory_order_acquire)) {
+                    ::beman::execution::set_error(std::move(this->st->outer), std::move(this->st->error));
+                    return;
+                }
+#endif
+                ::beman::execution::set_value(std::move(this->st->outer));
+            }
+            template <typename E>
+            void set_error(E&& e) && noexcept {
+                ::beman::execution::set_error(std::move(this->st->outer), std::forward<E>(e));
+            }
+            void set_stopped() && noexcept { ::beman::execution::set_stopped(std::move(this->st->outer)); }
+            auto get_env() const noexcept { return ::beman::execution::get_env(this->st->outer); }
+        };
+
+        std::remove_cvref_t<Receiver> outer;
+        Fn                            fn;
+        // Number of calls made on completion of the schedule operation without a native schedule_bulk.
+        ::std::size_t                 serial;
+        ::std::atomic<bool>           failed{false};
+        ::std::exception_ptr          error;
+        state<receiver>               op;
+
+        template <::beman::execution::receiver R, typename F>
+        bulk_state(R&& r, poly<base, 4 * sizeof(void*)>& sched, ::std::size_t count, F&& f)
+            : outer(std::forward<R>(r)),
+              fn(std::forward<F>(f)),
+              serial(sched->native_bulk() ? 0u : count),
+              op(receiver{this}, [this, &sched, count](state_base* b) {
+                  return sched->schedule_bulk(count, bulk_function{this, &bulk_state::call}, b);
+              }) {}
+        bulk_state(bulk_state&&) = delete;
+        void start() & noexcept { this->op.start(); }
+
+        static void call(void* self, ::std::size_t index) noexcept {
+            auto* st{static_cast<bulk_state*>(self)};
+            BEMAN_TASK_TRY {
+                st->fn(index);
+            }
+            BEMAN_TASK_CATCH_ALL {
+                if (not st->failed.exchange(true, ::std::memory_order_acq_rel)) {
+                    st->error = ::std::current_exception();
+                }
+            }
+        }
+    };
+    template <typename Fn>
+    class bulk_sender {
+      public:
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = sender::completion_signatures;
+
+        template <typename F>
+        bulk_sender(const poly<base, 4 * sizeof(void*)>& s, ::std::size_t c, F&& f)
+            : sched(s), count(c), fn(std::forward<F>(f)) {}
+
+        template <::beman::execution::receiver R>
+        bulk_state<R, Fn> connect(R&& r) && {
+            return bulk_state<R, Fn>(std::forward<R>(r), this->sched, this->count, std::move(this->fn));
+        }
+
+      private:
+        poly<base, 4 * sizeof(void*)> sched;
+        ::std::size_t                 count;
+        Fn                            fn;
+    };
+
   public:
     using scheduler_concept = ::beman::execution::scheduler_t;
 
@@ -236,12 +418,24 @@ class task_scheduler {
     ~task_scheduler()                                = default;
 
     sender schedule() { return this->scheduler->schedule(); }
+    template <typename Fn>
+    bulk_sender<::std::decay_t<Fn>> schedule_bulk(::std::size_t count, Fn&& fn) {
+        return bulk_sender<::std::decay_t<Fn>>(this->scheduler, count, std::forward<Fn>(fn));
+    }
     bool   operator==(const task_scheduler&) const = default;
     template <typename Sched>
         requires(not ::std::same_as<task_scheduler, Sched>) && ::beman::execution::scheduler<Sched>
     bool operator==(const Sched& other [[maybe_unused]]) const {
         return *this == task_scheduler(other);
     }
+
+    /*!
+     * \brief Determine whether the underlying scheduler has its own `schedule_bulk`
+     *
+     * If it doesn't, `schedule_bulk(count, fn)` runs all calls sequentially
+     * as one item scheduled on the underlying scheduler.
+     */
+    bool has_native_schedule_bulk() const noexcept { return this->scheduler->native_bulk(); }
 };
 static_assert(::beman::execution::scheduler<task_scheduler>);
 
@@ -0,0 +1,291 @@
+// include/beman/task/detail/task_scope.hpp                           -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TASK_SCOPE
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TASK_SCOPE
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Scope for fire-and-forget work with pooled operation states
+ * \headerfile beman/task/task_scope.hpp <beman/task/task_scope.hpp>
+ *
+ * `spawn(sndr)` connects `sndr` and starts the resulting operation, keeping
+ * it alive until it completes. `join()` yields a sender completing once
+ * the scope has no outstanding work. Spawned work gets an environment
+ * providing the scope's stop token, which is triggered by
+ * `request_stop()`, and the scope's allocator. A spawned sender
+ * completing with an error terminates the program.
+ *
+ * The operation states are not allocated individually: their storage is
+ * taken from a slab owned by the scope. The slab keeps free lists for
+ * blocks in steps of 64 bytes, the block being selected from the size of
+ * the connected operation state at compile time. Memory is obtained in
+ * chunks of several blocks from the scope's allocator and is reused
+ * until the scope is destroyed; only operation states larger than the
+ * biggest block are allocated directly. Thus, spawning a `task` only
+ * allocates its coroutine frame. Use the scope's allocator for the task,
+ * too, to have all memory come from the same allocator.
+ *
+ * The scope must be empty when it is destroyed.
+ *
+ * Usage:
+ *
+ *     task_scope scope;
+ *     scope.spawn(ex::detail::write_env(handle(request), ex::detail::make_env(ex::get_scheduler, sched)));
+ *     co_await scope.join();
+ */
+template <typename Allocator = ::std::allocator<::std::byte>>
+class task_scope {
+  public:
+    using allocator_type = Allocator;
+    class join_sender;
+
+    explicit task_scope(const Allocator& alloc = Allocator()) : allocator(alloc) {}
+    task_scope(const task_scope&)            = delete;
+    task_scope& operator=(const task_scope&) = delete;
+    ~task_scope() {
+        while (chunk* c = this->chunks) {
+            this->chunks = c->next;
+            byte_traits::deallocate(this->allocator, reinterpret_cast<::std::byte*>(c), c->size);
+        }
+    }
+
+    template <::beman::execution::sender Sender>
+    auto spawn(Sender&& sndr) -> void {
+        using job_t = job<::std::remove_cvref_t<Sender>>;
+        static_assert(alignof(job_t) <= alignof(::std::max_align_t));
+        void* storage{this->allocate(sizeof(job_t))};
+        job_t* j{};
+        BEMAN_TASK_TRY {
+            j = new (storage) job_t(this, ::std::forward<Sender>(sndr));
+        }
+        BEMAN_TASK_CATCH_ALL {
+            this->deallocate(storage, sizeof(job_t));
+            ::beman::task::detail::rethrow();
+        }
+        this->retain();
+        j->start();
+    }
+    auto join() noexcept -> join_sender { return join_sender{this}; }
+    auto request_stop() noexcept -> void { this->source.request_stop(); }
+    auto get_stop_token() const noexcept -> ::beman::execution::inplace_stop_token {
+        return this->source.get_token();
+    }
+    auto get_allocator() const noexcept -> allocator_type { return allocator_type(this->allocator); }
+
+    /*!
+     * \brief Account for work tracked outside of the scope, e.g., a `detached_task`.
+     */
+    auto retain() noexcept -> void { this->count.fetch_add(1u, ::std::memory_order_relaxed); }
+    /*!
+     * \brief Report completion of work accounted for by `retain()`.
+     */
+    auto release() noexcept -> void {
+        ::std::size_t current{this->count.load(::std::memory_order_relaxed)};
+        while (1u < current) {
+            if (this->count.compare_exchange_weak(
+                    current, current - 1u, ::std::memory_order_acq_rel, ::std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        // The last decrement and taking the joiners happen under the lock:
+        // once the count is zero a join may complete and the scope may be
+        // destroyed, i.e., the scope isn't accessed after unlocking.
+        join_node* waiters{};
+        {
+            ::std::lock_guard guard(this->mutex);
+            if (1u == this->count.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+                waiters = ::std::exchange(this->joiners, nullptr);
+            }
+        }
+        while (waiters) {
+            ::std::exchange(waiters, waiters->next)->complete();
+        }
+    }
+
+  private:
+    using byte_allocator = typename ::std::allocator_traits<Allocator>::template rebind_alloc<::std::byte>;
+    using byte_traits    = ::std::allocator_traits<byte_allocator>;
+
+    static constexpr ::std::size_t granularity{64u};
+    static constexpr ::std::size_t classes{32u};
+    static constexpr ::std::size_t blocks_per_chunk{16u};
+
+    struct free_block {
+        free_block* next;
+    };
+    struct alignas(::std::max_align_t) chunk {
+        chunk*        next;
+        ::std::size_t size;
+    };
+
+    struct env {
+        const task_scope* self;
+
+        auto query(const ::beman::execution::get_stop_token_t&) const noexcept
+            -> ::beman::execution::inplace_stop_token {
+            return this->self->source.get_token();
+        }
+        auto query(const ::beman::execution::get_allocator_t&) const noexcept -> allocator_type {
+            return this->self->get_allocator();
+        }
+    };
+    struct job_base {
+        virtual auto destroy() noexcept -> void = 0;
+
+      protected:
+        ~job_base() = default;
+    };
+    struct receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        task_scope* self;
+        job_base*   job;
+
+        auto set_value(auto&&...) && noexcept -> void { this->self->complete(this->job); }
+        auto set_error(auto&&) && noexcept -> void { ::std::terminate(); }
+        auto set_stopped() && noexcept -> void { this->self->complete(this->job); }
+        auto get_env() const noexcept -> env { return {this->self}; }
+    };
+    template <typename Sender>
+    struct job final : job_base {
+        using state_t = decltype(::beman::execution::connect(::std::declval<Sender>(), ::std::declval<receiver>()));
+
+        task_scope* self;
+        state_t     state;
+
+        template <typename S>
+        job(task_scope* s, S&& sndr)
+            : self(s), state(::beman::execution::connect(::std::forward<S>(sndr), receiver{s, this})) {}
+        auto start() noexcept -> void { ::beman::execution::start(this->state); }
+        auto destroy() noexcept -> void override {
+            task_scope* s{this->self};
+            this->~job();
+            s->deallocate(this, sizeof(job));
+        }
+    };
+    struct join_node {
+        join_node*   next{};
+        virtual auto complete() noexcept -> void = 0;
+
+      protected:
+        ~join_node() = default;
+    };
+
+    static constexpr auto size_class(::std::size_t size) noexcept -> ::std::size_t {
+        return (size + granularity - 1u) / granularity - 1u;
+    }
+    auto allocate(::std::size_t size) -> void* {
+        ::std::size_t cls{task_scope::size_class(size)};
+        if (classes <= cls) {
+            return byte_traits::allocate(this->allocator, size);
+        }
+        ::std::lock_guard guard(this->mutex);
+        if (this->free[cls] == nullptr) {
+            this->refill(cls);
+        }
+        free_block* block{this->free[cls]};
+        this->free[cls] = block->next;
+        return block;
+    }
+    auto deallocate(void* ptr, ::std::size_t size) noexcept -> void {
+        ::std::size_t cls{task_scope::size_class(size)};
+        if (classes <= cls) {
+            byte_traits::deallocate(this->allocator, static_cast<::std::byte*>(ptr), size);
+            return;
+        }
+        ::std::lock_guard guard(this->mutex);
+        this->free[cls] = new (ptr) free_block{this->free[cls]};
+    }
+    // Called with the lock held.
+    auto refill(::std::size_t cls) -> void {
+        ::std::size_t block{(cls + 1u) * granularity};
+        ::std::size_t size{sizeof(chunk) + blocks_per_chunk * block};
+        ::std::byte*  memory{byte_traits::allocate(this->allocator, size)};
+        this->chunks = new (memory) chunk{this->chunks, size};
+        for (::std::size_t i{blocks_per_chunk}; i-- != 0u;) {
+            this->free[cls] = new (memory + sizeof(chunk) + i * block) free_block{this->free[cls]};
+        }
+    }
+
+    auto complete(job_base* j) noexcept -> void {
+        j->destroy();
+        this->release();
+    }
+    auto add_joiner(join_node* n) noexcept -> bool {
+        ::std::lock_guard guard(this->mutex);
+        if (this->count.load(::std::memory_order_acquire) == 0u) {
+            return false;
+        }
+        n->next       = this->joiners;
+        this->joiners = n;
+        return true;
+    }
+
+    byte_allocator                          allocator;
+    ::beman::execution::inplace_stop_source source;
+    ::std::atomic<::std::size_t>            count{0u};
+    ::std::mutex                            mutex;
+    ::std::array<free_block*, classes>      free{};
+    chunk*                                  chunks{};
+    join_node*                              joiners{};
+};
+
+/*!
+ * \brief Sender completing once a `task_scope` is empty
+ * \headerfile beman/task/task_scope.hpp <beman/task/task_scope.hpp>
+ */
+template <typename Allocator>
+class task_scope<Allocator>::join_sender {
+  public:
+    using sender_concept        = ::beman::execution::sender_t;
+    using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t()>;
+
+    template <typename Receiver>
+    struct state : task_scope::join_node {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+
+        ::std::remove_cvref_t<Receiver> receiver;
+        task_scope*                     scope;
+
+        template <typename R>
+        state(R&& r, task_scope* s) : receiver(::std::forward<R>(r)), scope(s) {}
+        state(state&&) = delete;
+
+        auto start() & noexcept -> void {
+            if (not this->scope->add_joiner(this)) {
+                this->complete();
+            }
+        }
+        auto complete() noexcept -> void override { ::beman::execution::set_value(::std::move(this->receiver)); }
+    };
+
+    explicit join_sender(task_scope* s) : scope(s) {}
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) const -> state<Receiver> {
+        return state<Receiver>(::std::forward<Receiver>(receiver), this->scope);
+    }
+
+  private:
+    task_scope* scope;
+};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
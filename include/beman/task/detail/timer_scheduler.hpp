@@ -0,0 +1,445 @@
+// include/beman/task/detail/timer_scheduler.hpp                      -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TIMER_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TIMER_SCHEDULER
+
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Timer service based on a hierarchical timing wheel
+ * \headerfile beman/task/timer_scheduler.hpp <beman/task/timer_scheduler.hpp>
+ *
+ * A `timer_context` runs a thread completing timers when they expire. Time
+ * is divided into ticks of the resolution passed to the constructor and
+ * timers are kept in a hierarchy of wheels of 64 slots: the first wheel
+ * holds timers expiring within the next 64 ticks, the next wheel those
+ * within the next 64 * 64 ticks, etc. Timers move down the hierarchy as
+ * time advances. Arming and cancelling a timer are O(1) operations. The
+ * thread only wakes up for ticks at which a timer expires or timers move
+ * down the hierarchy, not for every tick.
+ *
+ * Timers complete with `set_value()` on the context's thread no earlier
+ * than their expiry time. When stop is requested on the receiver's stop
+ * token, the timer is removed immediately and completes with
+ * `set_stopped()` on the thread requesting stop. Timers outstanding when
+ * the context is destroyed complete with `set_stopped()`.
+ *
+ * Usage:
+ *
+ *     timer_context timers;
+ *     co_await schedule_after(timers.get_scheduler(), 10ms);
+ */
+class timer_context {
+  public:
+    using clock_type = ::std::chrono::steady_clock;
+
+    class scheduler;
+
+    explicit timer_context(clock_type::duration resolution = ::std::chrono::milliseconds(1))
+        : tick(::std::max(resolution, clock_type::duration(1))),
+          origin(clock_type::now()),
+          thread([this] { this->run(); }) {}
+    timer_context(const timer_context&)            = delete;
+    timer_context& operator=(const timer_context&) = delete;
+    ~timer_context() {
+        {
+            ::std::lock_guard guard(this->mutex);
+            this->done = true;
+        }
+        this->condition.notify_one();
+        this->thread.join();
+    }
+
+    auto get_scheduler() -> scheduler;
+
+  private:
+    static constexpr ::std::size_t   bits{6u};
+    static constexpr ::std::size_t   slots{::std::size_t(1u) << bits};
+    static constexpr ::std::size_t   levels{6u};
+    static constexpr ::std::uint64_t mask{slots - 1u};
+    static constexpr ::std::uint64_t idle{~::std::uint64_t()};
+
+    enum class phase : unsigned char { idle, armed, fired, cancelled };
+
+    // Timers are kept in circular doubly linked lists to support O(1) removal.
+    struct link {
+        link* next{this};
+        link* prev{this};
+
+        link()            = default;
+        link(const link&) = delete;
+        auto empty() const noexcept -> bool { return this->next == this; }
+        auto push_back(link* l) noexcept -> void {
+            l->prev       = this->prev;
+            l->next       = this;
+            l->prev->next = l;
+            this->prev    = l;
+        }
+        auto unlink() noexcept -> void {
+            this->prev->next = this->next;
+            this->next->prev = this->prev;
+            this->next = this->prev = this;
+        }
+        auto splice_to(link& other) noexcept -> void {
+            if (not this->empty()) {
+                this->next->prev = other.prev;
+                other.prev->next = this->next;
+                this->prev->next = &other;
+                other.prev       = this->prev;
+                this->next = this->prev = this;
+            }
+        }
+    };
+    struct node : link {
+        ::std::uint64_t expiry{};
+        phase           state{phase::idle};
+        virtual auto    fire(bool expired) noexcept -> void = 0;
+
+      protected:
+        ~node() = default;
+    };
+
+    auto floor_tick(clock_type::time_point tp) const -> ::std::uint64_t {
+        return tp <= this->origin ? 0u : ::std::uint64_t((tp - this->origin) / this->tick);
+    }
+    auto ceil_tick(clock_type::time_point tp) const -> ::std::uint64_t {
+        if (tp <= this->origin) {
+            return 0u;
+        }
+        auto elapsed{tp - this->origin};
+        return ::std::uint64_t(elapsed / this->tick) + (elapsed % this->tick != clock_type::duration::zero());
+    }
+    auto time_of(::std::uint64_t t) const -> clock_type::time_point {
+        return this->origin + this->tick * clock_type::duration::rep(t);
+    }
+
+    // The caller holds the lock.
+    auto place(node* n) -> void {
+        if (n->expiry <= this->current) {
+            this->due.push_back(n);
+            return;
+        }
+        ::std::uint64_t delta{n->expiry - this->current};
+        ::std::size_t   level{};
+        while (level + 1u != levels && (delta >> (bits * (level + 1u))) != 0u) {
+            ++level;
+        }
+        this->wheels[level][(n->expiry >> (bits * level)) & mask].push_back(n);
+    }
+    // The caller holds the lock. Returns the first tick after current at which
+    // a timer becomes due or a non-empty slot of an upper wheel is cascaded
+    // (idle if there is none). Each wheel is scanned for its first non-empty
+    // slot, i.e., at most slots * levels slots are looked at.
+    auto next_event() const -> ::std::uint64_t {
+        ::std::uint64_t next{idle};
+        for (::std::size_t level{}; level != levels; ++level) {
+            ::std::uint64_t base{this->current >> (bits * level)};
+            for (::std::uint64_t i{1u}; i <= slots; ++i) {
+                if (not this->wheels[level][(base + i) & mask].empty()) {
+                    next = ::std::min(next, (base + i) << (bits * level));
+                    break;
+                }
+            }
+        }
+        return next;
+    }
+    // The caller holds the lock. Moves all timers expiring up to target to the due list.
+    auto advance(::std::uint64_t target) -> void {
+        while (this->current < target) {
+            // Ticks without due timers or cascades are skipped.
+            ::std::uint64_t next{this->next_event()};
+            if (target < next) {
+                this->current = target;
+                break;
+            }
+            this->current = next;
+            for (::std::size_t level{1u}; level != levels; ++level) {
+                if ((this->current & ((::std::uint64_t(1u) << (bits * level)) - 1u)) != 0u) {
+                    break;
+                }
+                link cascade;
+                this->wheels[level][(this->current >> (bits * level)) & mask].splice_to(cascade);
+                while (not cascade.empty()) {
+                    auto* n{static_cast<node*>(cascade.next)};
+                    n->unlink();
+                    this->place(n);
+                }
+            }
+            this->wheels[0u][this->current & mask].splice_to(this->due);
+        }
+    }
+
+    auto arm(node* n, clock_type::time_point expiry) -> bool {
+        bool notify{};
+        {
+            ::std::lock_guard guard(this->mutex);
+            if (n->state == phase::cancelled) {
+                return false;
+            }
+            if (this->armed++ == 0u) {
+                // The wheels are empty: skip the ticks which passed while idle.
+                this->current = ::std::max(this->current, this->floor_tick(clock_type::now()));
+            }
+            n->state  = phase::armed;
+            n->expiry = this->ceil_tick(expiry);
+            this->place(n);
+            // The thread only needs to be woken up if it would sleep past the expiry.
+            if (not this->due.empty() || n->expiry < this->wakeup) {
+                this->wakeup = 0u;
+                notify       = true;
+            }
+        }
+        if (notify) {
+            this->condition.notify_one();
+        }
+        return true;
+    }
+    // Returns true if the timer was removed and needs to be completed by the caller.
+    auto cancel(node* n) -> bool {
+        ::std::lock_guard guard(this->mutex);
+        switch (n->state) {
+        case phase::idle:
+            n->state = phase::cancelled;
+            return false;
+        case phase::armed:
+            n->unlink();
+            --this->armed;
+            n->state = phase::cancelled;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    auto run() -> void {
+        ::std::unique_lock guard(this->mutex);
+        while (not this->done) {
+            this->advance(this->floor_tick(clock_type::now()));
+            if (this->due.empty()) {
+                // Sleep until the next tick with work: a due timer or a cascade.
+                auto target{this->armed == 0u ? idle : this->next_event()};
+                auto woken{[this, target] { return this->done || this->wakeup != target; }};
+                this->wakeup = target;
+                if (target == idle) {
+                    this->condition.wait(guard, woken);
+                } else {
+                    this->condition.wait_until(guard, this->time_of(target), woken);
+                }
+                continue;
+            }
+            this->complete(guard, true);
+        }
+        for (auto& wheel : this->wheels) {
+            for (auto& slot : wheel) {
+                slot.splice_to(this->due);
+            }
+        }
+        this->complete(guard, false);
+    }
+    auto complete(::std::unique_lock<::std::mutex>& guard, bool expired) -> void {
+        link ready;
+        this->due.splice_to(ready);
+        for (link* l{ready.next}; l != &ready; l = l->next) {
+            static_cast<node*>(l)->state = phase::fired;
+            --this->armed;
+        }
+        guard.unlock();
+        while (not ready.empty()) {
+            auto* n{static_cast<node*>(ready.next)};
+            n->unlink();
+            n->fire(expired);
+        }
+        guard.lock();
+    }
+
+    using wheel = ::std::array<link, slots>;
+
+    clock_type::duration        tick;
+    clock_type::time_point      origin;
+    ::std::mutex                mutex;
+    ::std::condition_variable   condition;
+    ::std::array<wheel, levels> wheels{};
+    link                        due;
+    ::std::uint64_t             current{};
+    ::std::uint64_t             wakeup{idle};
+    ::std::size_t               armed{};
+    bool                        done{false};
+    ::std::thread               thread;
+};
+
+/*!
+ * \brief Scheduler of a `timer_context`
+ * \headerfile beman/task/timer_scheduler.hpp <beman/task/timer_scheduler.hpp>
+ *
+ * In addition to `schedule()`, which completes as soon as possible on the
+ * context's thread, the scheduler provides the senders
+ * `schedule_at(time_point)` and `schedule_after(duration)`. The duration
+ * of `schedule_after` is measured from the time the operation is started.
+ */
+class timer_context::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    struct env {
+        timer_context* context;
+
+        auto query(const ::beman::execution::get_completion_scheduler_t<::beman::execution::set_value_t>&)
+            const noexcept -> scheduler {
+            return scheduler(this->context);
+        }
+    };
+    template <::beman::execution::receiver Receiver>
+    struct state : timer_context::node {
+        using operation_state_concept = ::beman::execution::operation_state_t;
+        struct stopper {
+            state* st;
+            auto   operator()() const noexcept -> void {
+                if (this->st->context->cancel(this->st)) {
+                    ::beman::execution::set_stopped(::std::move(this->st->receiver));
+                }
+            }
+        };
+        using stop_token_t =
+            decltype(::beman::execution::get_stop_token(::beman::execution::get_env(::std::declval<Receiver&>())));
+        using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stopper>;
+
+        ::std::remove_cvref_t<Receiver>  receiver;
+        timer_context*                   context;
+        clock_type::time_point           at;
+        clock_type::duration             after;
+        ::std::optional<stop_callback_t> callback;
+
+        template <typename R>
+        state(R&& r, timer_context* c, clock_type::time_point a, clock_type::duration d)
+            : receiver(::std::forward<R>(r)), context(c), at(a), after(d) {}
+        state(state&&) = delete;
+
+        auto start() & noexcept -> void {
+            auto token{::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver))};
+            if (token.stop_requested()) {
+                ::beman::execution::set_stopped(::std::move(this->receiver));
+                return;
+            }
+            if (token.stop_possible()) {
+                // A stop request before the timer is armed only marks it as cancelled.
+                this->callback.emplace(token, stopper{this});
+            }
+            auto expiry{this->at == clock_type::time_point::min() ? clock_type::now() + this->after : this->at};
+            if (not this->context->arm(this, expiry)) {
+                this->callback.reset();
+                ::beman::execution::set_stopped(::std::move(this->receiver));
+            }
+        }
+        auto fire(bool expired) noexcept -> void override {
+            this->callback.reset();
+            if (expired) {
+                ::beman::execution::set_value(::std::move(this->receiver));
+            } else {
+                ::beman::execution::set_stopped(::std::move(this->receiver));
+            }
+        }
+    };
+    struct sender {
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::
+            completion_signatures<::beman::execution::set_value_t(), ::beman::execution::set_stopped_t()>;
+
+        timer_context*         context;
+        clock_type::time_point at;
+        clock_type::duration   after{};
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) const -> state<Receiver> {
+            return state<Receiver>(::std::forward<Receiver>(receiver), this->context, this->at, this->after);
+        }
+        auto get_env() const noexcept -> env { return {this->context}; }
+    };
+
+    explicit scheduler(timer_context* c) : context(c) {}
+
+    auto schedule() const noexcept -> sender { return {this->context, clock_type::time_point::min()}; }
+    auto schedule_at(clock_type::time_point tp) const noexcept -> sender { return {this->context, tp}; }
+    auto schedule_after(clock_type::duration d) const noexcept -> sender {
+        return {this->context, clock_type::time_point::min(), d};
+    }
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    timer_context* context;
+};
+
+inline auto timer_context::get_scheduler() -> scheduler { return scheduler(this); }
+
+using timer_scheduler = ::beman::task::detail::timer_context::scheduler;
+static_assert(::beman::execution::scheduler<timer_scheduler>);
+
+/*!
+ * \brief Customization point object to get a sender completing at a given time
+ * \headerfile beman/task/timer_scheduler.hpp <beman/task/timer_scheduler.hpp>
+ *
+ * `schedule_at(scheduler, time_point)` yields `scheduler.schedule_at(time_point)`.
+ */
+struct schedule_at_t {
+    template <typename Scheduler, typename TimePoint>
+        requires requires(const Scheduler& s, const TimePoint& tp) { s.schedule_at(tp); }
+    auto operator()(const Scheduler& scheduler, const TimePoint& tp) const {
+        return scheduler.schedule_at(tp);
+    }
+};
+
+/*!
+ * \brief Customization point object to get a sender completing after a duration
+ * \headerfile beman/task/timer_scheduler.hpp <beman/task/timer_scheduler.hpp>
+ *
+ * `schedule_after(scheduler, duration)` yields `scheduler.schedule_after(duration)`.
+ */
+struct schedule_after_t {
+    template <typename Scheduler, typename Duration>
+        requires requires(const Scheduler& s, const Duration& d) { s.schedule_after(d); }
+    auto operator()(const Scheduler& scheduler, const Duration& d) const {
+        return scheduler.schedule_after(d);
+    }
+};
+
+inline constexpr schedule_at_t    schedule_at{};
+inline constexpr schedule_after_t schedule_after{};
+
+/*!
+ * \brief Query for the `timer_scheduler` to be used by timed algorithms
+ * \headerfile beman/task/timer_scheduler.hpp <beman/task/timer_scheduler.hpp>
+ *
+ * The query `get_timer_scheduler(env)` yields the `timer_scheduler` used,
+ * e.g., by `with_timeout` when no scheduler is passed explicitly. It is a
+ * forwarding query: a `task` whose context answers it makes it available
+ * to all senders the task awaits.
+ */
+struct get_timer_scheduler_t {
+    template <typename Env>
+        requires requires(const Env& env, const get_timer_scheduler_t& q) { env.query(q); }
+    auto operator()(const Env& env) const noexcept -> ::beman::task::detail::timer_scheduler {
+        return env.query(*this);
+    }
+    constexpr auto query(const ::beman::execution::forwarding_query_t&) const noexcept -> bool { return true; }
+};
+
+inline constexpr get_timer_scheduler_t get_timer_scheduler{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
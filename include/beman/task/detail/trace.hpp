@@ -0,0 +1,65 @@
+// include/beman/task/detail/trace.hpp                                -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TRACE
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_TRACE
+
+#include <atomic>
+
+// ----------------------------------------------------------------------------
+// Diagnostics of the library, e.g., an awaiter rescheduling the awaiting
+// coroutine, are reported to a trace_handler registered with
+// set_trace_handler() rather than written to a stream: the headers don't
+// include <iostream> and, without a registered handler, a trace point costs
+// a relaxed load and a branch. Defining BEMAN_TASK_NO_TRACE removes the
+// trace points entirely.
+
+namespace beman::task::detail {
+/*!
+ * \brief Type of functions receiving the library's diagnostic events
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * The handler is called with a static string naming the event and the
+ * address of the object reporting it. It may be called concurrently from
+ * different threads.
+ */
+using trace_handler = void (*)(const char* event, const void* object) noexcept;
+
+/*!
+ * \brief Storage of the currently registered `trace_handler`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+inline auto trace_handler_storage() noexcept -> ::std::atomic<trace_handler>& {
+    static ::std::atomic<trace_handler> handler{nullptr};
+    return handler;
+}
+
+/*!
+ * \brief Register a function receiving the library's diagnostic events
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * Passing `nullptr` turns tracing off. The previously registered handler
+ * is returned.
+ */
+inline auto set_trace_handler(trace_handler handler) noexcept -> trace_handler {
+    return ::beman::task::detail::trace_handler_storage().exchange(handler);
+}
+
+/*!
+ * \brief Report the diagnostic event `event` of `object`
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ * \internal
+ */
+inline auto trace([[maybe_unused]] const char* event, [[maybe_unused]] const void* object) noexcept -> void {
+#ifndef BEMAN_TASK_NO_TRACE
+    if (trace_handler handler{::beman::task::detail::trace_handler_storage().load(::std::memory_order_relaxed)}) {
+        handler(event, object);
+    }
+#endif
+}
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,177 @@
+// include/beman/task/detail/wakeup_loop.hpp                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WAKEUP_LOOP
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WAKEUP_LOOP
+
+#include <beman/task/detail/eventfd_wakeup.hpp>
+#ifdef BEMAN_TASK_HAS_EVENTFD
+
+#include <beman/execution/execution.hpp>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Scheduler loop parking on an `eventfd_wakeup`
+ * \headerfile beman/task/wakeup_loop.hpp <beman/task/wakeup_loop.hpp>
+ *
+ * The loop has the interface of `run_loop`: `run()` executes the work
+ * scheduled on `get_scheduler()` until `finish()` is called. Instead of a
+ * condition variable the thread blocks on an `eventfd_wakeup`, i.e.,
+ * scheduling work while the loop is busy doesn't issue any system call.
+ * `drain()` and `wakeup()` allow running the loop from a thread which
+ * also waits for I/O: register `wakeup().native_handle()` and call
+ * `drain()` whenever the thread isn't blocked.
+ */
+class wakeup_loop {
+  public:
+    class scheduler;
+
+    wakeup_loop()                              = default;
+    wakeup_loop(const wakeup_loop&)            = delete;
+    wakeup_loop& operator=(const wakeup_loop&) = delete;
+
+    auto get_scheduler() -> scheduler;
+
+    auto run() -> void {
+        while (not this->drain()) {
+            if (this->notifier.prepare_wait()) {
+                this->notifier.wait();
+            }
+        }
+    }
+    auto finish() -> void {
+        {
+            ::std::lock_guard guard(this->mutex);
+            this->done = true;
+        }
+        this->notifier.notify();
+    }
+    /*!
+     * \brief Execute all queued work; returns whether `finish()` was called.
+     */
+    auto drain() -> bool {
+        while (true) {
+            node* batch{};
+            bool  stop{};
+            {
+                ::std::lock_guard guard(this->mutex);
+                batch = ::std::exchange(this->head, nullptr);
+                stop  = this->done;
+            }
+            if (batch == nullptr) {
+                return stop;
+            }
+            while (batch) {
+                // Running the node may destroy it.
+                ::std::exchange(batch, batch->next)->run();
+            }
+        }
+    }
+    auto wakeup() noexcept -> ::beman::task::detail::eventfd_wakeup& { return this->notifier; }
+
+  private:
+    template <typename Receiver>
+    struct state;
+
+    struct node {
+        node*        next{};
+        virtual auto run() noexcept -> void = 0;
+
+      protected:
+        ~node() = default;
+    };
+
+    auto push(node* n) noexcept -> void {
+        {
+            ::std::lock_guard guard(this->mutex);
+            (this->head ? this->tail->next : this->head) = n;
+            this->tail                                   = n;
+        }
+        this->notifier.notify();
+    }
+
+    ::beman::task::detail::eventfd_wakeup notifier;
+    ::std::mutex                          mutex;
+    node*                                 head{};
+    node*                                 tail{};
+    bool                                  done{false};
+};
+
+/*!
+ * \brief Operation state of the `wakeup_loop` scheduler's sender
+ * \headerfile beman/task/wakeup_loop.hpp <beman/task/wakeup_loop.hpp>
+ * \internal
+ */
+template <typename Receiver>
+struct wakeup_loop::state : wakeup_loop::node {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+
+    ::std::remove_cvref_t<Receiver> receiver;
+    wakeup_loop*                    loop;
+
+    template <typename R>
+    state(R&& r, wakeup_loop* l) : receiver(::std::forward<R>(r)), loop(l) {}
+    state(state&&) = delete;
+
+    auto start() & noexcept -> void { this->loop->push(this); }
+    auto run() noexcept -> void override {
+        if (::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver)).stop_requested()) {
+            ::beman::execution::set_stopped(::std::move(this->receiver));
+        } else {
+            ::beman::execution::set_value(::std::move(this->receiver));
+        }
+    }
+};
+
+/*!
+ * \brief Scheduler of a `wakeup_loop`
+ * \headerfile beman/task/wakeup_loop.hpp <beman/task/wakeup_loop.hpp>
+ */
+class wakeup_loop::scheduler {
+  public:
+    using scheduler_concept = ::beman::execution::scheduler_t;
+
+    struct env {
+        wakeup_loop* loop;
+
+        auto query(const ::beman::execution::get_completion_scheduler_t<::beman::execution::set_value_t>&)
+            const noexcept -> scheduler {
+            return scheduler(this->loop);
+        }
+    };
+    struct sender {
+        using sender_concept        = ::beman::execution::sender_t;
+        using completion_signatures = ::beman::execution::completion_signatures<::beman::execution::set_value_t(),
+                                                                                ::beman::execution::set_stopped_t()>;
+
+        wakeup_loop* loop;
+
+        template <::beman::execution::receiver Receiver>
+        auto connect(Receiver&& receiver) const -> wakeup_loop::state<Receiver> {
+            return wakeup_loop::state<Receiver>(::std::forward<Receiver>(receiver), this->loop);
+        }
+        auto get_env() const noexcept -> env { return {this->loop}; }
+    };
+
+    explicit scheduler(wakeup_loop* l) : loop(l) {}
+
+    auto schedule() const noexcept -> sender { return {this->loop}; }
+    auto operator==(const scheduler&) const -> bool = default;
+
+  private:
+    wakeup_loop* loop;
+};
+
+inline auto wakeup_loop::get_scheduler() -> scheduler { return scheduler(this); }
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+#endif
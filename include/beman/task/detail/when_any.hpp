@@ -0,0 +1,228 @@
+// include/beman/task/detail/when_any.hpp                             -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WHEN_ANY
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WHEN_ANY
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/meta.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Sender algorithm racing a number of senders
+ * \headerfile beman/task/when_any.hpp <beman/task/when_any.hpp>
+ *
+ * The sender `when_any(sndr...)` starts all senders `sndr...` and
+ * completes with the first `set_value` completion produced by any of them.
+ * As soon as a value is produced, stop is requested on the remaining
+ * senders using the stop token provided to them. The result is only
+ * delivered once all senders have completed, i.e., the operation states
+ * of the losers are never destroyed while they are still running.
+ *
+ * If none of the senders produces a value, the first `set_error` or
+ * `set_stopped` completion is delivered. This way a fast failure of one
+ * replica doesn't prevent a slower replica from providing a result.
+ *
+ * Stop requests of the receiver are forwarded to all senders. Other
+ * forwarding queries are answered by the receiver's environment. When
+ * `co_await`ed from a `task` the task resumes on its own scheduler as
+ * for any other sender.
+ *
+ * Completion signatures: the union of the completion signatures of
+ * all senders plus `set_error_t(std::exception_ptr)` (for failures to
+ * store the result) and `set_stopped_t()`.
+ *
+ * Usage:
+ *
+ *     auto [rc]{*ex::sync_wait(when_any(request(replica1), request(replica2)))};
+ */
+struct when_any_t {
+    template <typename Env, typename... Sender>
+    using completions = ::beman::task::detail::meta::unique_t<::beman::task::detail::meta::concat_t<
+        ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::exception_ptr),
+                                                  ::beman::execution::set_stopped_t()>,
+        ::beman::execution::completion_signatures_of_t<Sender, Env>...>>;
+
+    template <typename Receiver, typename... Sender>
+    struct state;
+    template <typename... Sender>
+    struct sender;
+
+    template <::beman::execution::sender... Sender>
+        requires(0u < sizeof...(Sender))
+    auto operator()(Sender&&... sndr) const {
+        using result_t = sender<::std::remove_cvref_t<Sender>...>;
+        static_assert(::beman::execution::sender<result_t>);
+        return result_t{::std::tuple<::std::remove_cvref_t<Sender>...>(::std::forward<Sender>(sndr)...)};
+    }
+};
+
+template <typename Receiver, typename... Sender>
+struct when_any_t::state {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+    using upstream_env            = decltype(::beman::execution::get_env(::std::declval<const Receiver&>()));
+    using result_t =
+        ::beman::task::detail::meta::completion_variant_t<when_any_t::completions<upstream_env, Sender...>>;
+
+    struct child_env {
+        const state* st;
+
+        auto query(const ::beman::execution::get_stop_token_t&) const noexcept
+            -> ::beman::execution::inplace_stop_token {
+            return this->st->source.get_token();
+        }
+        template <typename Q, typename... A>
+            requires requires(const upstream_env& e, Q q, A&&... a) {
+                ::beman::execution::forwarding_query(q);
+                q(e, ::std::forward<A>(a)...);
+            }
+        auto query(Q q, A&&... a) const noexcept {
+            return q(::beman::execution::get_env(this->st->receiver), ::std::forward<A>(a)...);
+        }
+    };
+
+    struct child_receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        state* st;
+
+        template <typename... A>
+        auto set_value(A&&... a) && noexcept -> void {
+            this->st->complete(::beman::execution::set_value, ::std::forward<A>(a)...);
+        }
+        template <typename E>
+        auto set_error(E&& e) && noexcept -> void {
+            this->st->complete(::beman::execution::set_error, ::std::forward<E>(e));
+        }
+        auto set_stopped() && noexcept -> void { this->st->complete(::beman::execution::set_stopped); }
+        auto get_env() const noexcept -> child_env { return {this->st}; }
+    };
+
+    template <::std::size_t I>
+    struct child {
+        using sender_t = ::std::tuple_element_t<I, ::std::tuple<Sender...>>;
+        using state_t =
+            decltype(::beman::execution::connect(::std::declval<sender_t>(), ::std::declval<child_receiver>()));
+        state_t op;
+        child(state* st, sender_t&& sndr) : op(::beman::execution::connect(::std::move(sndr), child_receiver{st})) {}
+    };
+    template <typename>
+    struct children;
+    template <::std::size_t... I>
+    struct children<::std::index_sequence<I...>> : child<I>... {
+        children(state* st, ::std::tuple<Sender...>&& sndrs)
+            : child<I>(st, ::std::get<I>(::std::move(sndrs)))... {}
+        auto start() noexcept -> void { (::beman::execution::start(static_cast<child<I>&>(*this).op), ...); }
+    };
+
+    struct stop_link {
+        ::beman::execution::inplace_stop_source& source;
+        auto operator()() const noexcept -> void { this->source.request_stop(); }
+    };
+    using stop_token_t    = decltype(::beman::execution::get_stop_token(::std::declval<upstream_env>()));
+    using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stop_link>;
+
+    ::std::remove_cvref_t<Receiver>                receiver;
+    ::beman::execution::inplace_stop_source        source;
+    ::std::optional<stop_callback_t>               stop_callback;
+    ::std::mutex                                   mutex;
+    result_t                                       result;
+    bool                                           has_value{false};
+    ::std::atomic<::std::size_t>                   remaining{sizeof...(Sender)};
+    children<::std::index_sequence_for<Sender...>> kids;
+
+    template <typename R>
+    state(R&& r, ::std::tuple<Sender...>&& sndrs)
+        : receiver(::std::forward<R>(r)), kids(this, ::std::move(sndrs)) {}
+    state(const state&)            = delete;
+    state(state&&)                 = delete;
+    state& operator=(const state&) = delete;
+    state& operator=(state&&)      = delete;
+    ~state()                       = default;
+
+    auto start() & noexcept -> void {
+        this->stop_callback.emplace(::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver)),
+                                    stop_link{this->source});
+        // The last child to complete delivers the result and may destroy
+        // this object: nothing may be accessed after starting the children.
+        this->kids.start();
+    }
+
+    template <typename Tag, typename... A>
+    auto complete(Tag, A&&... a) noexcept -> void {
+        constexpr bool is_value{::std::same_as<Tag, ::beman::execution::set_value_t>};
+        bool           won{false};
+        {
+            ::std::lock_guard guard(this->mutex);
+            if (not this->has_value && (is_value || this->result.index() == 0u)) {
+                BEMAN_TASK_TRY {
+                    this->result.template emplace<::std::tuple<Tag, ::std::decay_t<A>...>>(Tag{},
+                                                                                          ::std::forward<A>(a)...);
+                    won = this->has_value = is_value;
+                }
+                BEMAN_TASK_CATCH_ALL {
+                    this->result.template emplace<::std::tuple<::beman::execution::set_error_t, ::std::exception_ptr>>(
+                        ::beman::execution::set_error, ::std::current_exception());
+                }
+            }
+        }
+        if (won) {
+            this->source.request_stop();
+        }
+        this->finish();
+    }
+
+    auto finish() noexcept -> void {
+        if (1u == this->remaining.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+            this->stop_callback.reset();
+            ::std::visit(
+                [this]<typename T>(T& res) {
+                    if constexpr (::std::same_as<T, ::std::monostate>) {
+                        ::beman::execution::set_stopped(::std::move(this->receiver));
+                    } else {
+                        ::std::apply(
+                            [this](auto tag, auto&... arg) { tag(::std::move(this->receiver), ::std::move(arg)...); },
+                            res);
+                    }
+                },
+                this->result);
+        }
+    }
+};
+
+template <typename... Sender>
+struct when_any_t::sender {
+    using sender_concept = ::beman::execution::sender_t;
+
+    ::std::tuple<Sender...> senders;
+
+    template <typename Env>
+    auto get_completion_signatures(const Env&) const noexcept {
+        return when_any_t::completions<Env, Sender...>{};
+    }
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) && {
+        return when_any_t::state<::std::remove_cvref_t<Receiver>, Sender...>(::std::forward<Receiver>(receiver),
+                                                                             ::std::move(this->senders));
+    }
+};
+
+inline constexpr when_any_t when_any{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,267 @@
+// include/beman/task/detail/with_timeout.hpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WITH_TIMEOUT
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_WITH_TIMEOUT
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/meta.hpp>
+#include <beman/task/detail/timer_scheduler.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Sender algorithm limiting the time a sender may take
+ * \headerfile beman/task/with_timeout.hpp <beman/task/with_timeout.hpp>
+ *
+ * The sender `with_timeout(sndr, duration)` starts `sndr` and a timer
+ * expiring after `duration`. If the timer expires before `sndr` completes,
+ * stop is requested on `sndr` via the stop token provided to it. Stop
+ * requests of the receiver are forwarded to `sndr`, too. Once `sndr`
+ * completes the timer is cancelled and the result is delivered when both
+ * operations are done.
+ *
+ * If `sndr` completes with `set_stopped()` after the timer expired, the
+ * operation completes with `set_error(std::errc::timed_out)` (as a
+ * `std::error_code`). All other completions of `sndr` are passed through,
+ * i.e., a stop request of the receiver yields `set_stopped()`. When
+ * `co_await`ed from a `task`, the error code is thrown as a
+ * `std::system_error` unless the task's context opts into
+ * `report_error_codes`, in which case the task completes with the error
+ * code.
+ *
+ * The timer is embedded in the operation state: neither arming nor
+ * cancelling it allocates. The `timer_scheduler` running the timer is
+ * passed as third argument or, if it is omitted, obtained using
+ * `get_timer_scheduler` from the receiver's environment. There is no
+ * implicit timer thread: using `with_timeout` without a timer scheduler
+ * where none is provided by the environment doesn't compile.
+ *
+ * Usage:
+ *
+ *     auto rc{co_await with_timeout(request(server), 100ms, timers.get_scheduler())};
+ */
+struct with_timeout_t {
+    using duration = ::beman::task::detail::timer_context::clock_type::duration;
+
+    template <typename Env, typename Sender>
+    using completions = ::beman::task::detail::meta::unique_t<::beman::task::detail::meta::concat_t<
+        ::beman::execution::completion_signatures<::beman::execution::set_error_t(::std::exception_ptr),
+                                                  ::beman::execution::set_error_t(::std::error_code),
+                                                  ::beman::execution::set_stopped_t()>,
+        ::beman::execution::completion_signatures_of_t<Sender, Env>>>;
+
+    template <typename Receiver, typename Sender>
+    struct state;
+    template <typename Sender, typename Timer>
+    struct sender;
+    // Marker for a timer scheduler obtained from the receiver's environment.
+    struct env_timer {};
+
+    template <typename Env>
+    static auto timer_of(const Env& env, env_timer) -> ::beman::task::detail::timer_scheduler {
+        static_assert(requires { ::beman::task::detail::get_timer_scheduler(env); },
+                      "with_timeout(sndr, duration) needs a timer_scheduler: pass one as third argument or provide "
+                      "get_timer_scheduler in the receiver's environment");
+        return ::beman::task::detail::get_timer_scheduler(env);
+    }
+    template <typename Env>
+    static auto timer_of(const Env&, ::beman::task::detail::timer_scheduler timer)
+        -> ::beman::task::detail::timer_scheduler {
+        return timer;
+    }
+
+    template <::beman::execution::sender Sender>
+    auto operator()(Sender&& sndr, duration timeout) const {
+        using result_t = sender<::std::remove_cvref_t<Sender>, env_timer>;
+        return result_t{::std::forward<Sender>(sndr), timeout, env_timer{}};
+    }
+    template <::beman::execution::sender Sender>
+    auto operator()(Sender&& sndr, duration timeout, ::beman::task::detail::timer_scheduler timer) const {
+        using result_t = sender<::std::remove_cvref_t<Sender>, ::beman::task::detail::timer_scheduler>;
+        static_assert(::beman::execution::sender<result_t>);
+        return result_t{::std::forward<Sender>(sndr), timeout, timer};
+    }
+};
+
+template <typename Receiver, typename Sender>
+struct with_timeout_t::state {
+    using operation_state_concept = ::beman::execution::operation_state_t;
+    using upstream_env            = decltype(::beman::execution::get_env(::std::declval<const Receiver&>()));
+    using result_t =
+        ::beman::task::detail::meta::completion_variant_t<with_timeout_t::completions<upstream_env, Sender>>;
+
+    struct child_env {
+        const state* st;
+
+        auto query(const ::beman::execution::get_stop_token_t&) const noexcept
+            -> ::beman::execution::inplace_stop_token {
+            return this->st->source.get_token();
+        }
+        template <typename Q, typename... A>
+            requires requires(const upstream_env& e, Q q, A&&... a) {
+                ::beman::execution::forwarding_query(q);
+                q(e, ::std::forward<A>(a)...);
+            }
+        auto query(Q q, A&&... a) const noexcept {
+            return q(::beman::execution::get_env(this->st->receiver), ::std::forward<A>(a)...);
+        }
+    };
+    struct child_receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        state* st;
+
+        template <typename... A>
+        auto set_value(A&&... a) && noexcept -> void {
+            this->st->complete(::beman::execution::set_value, ::std::forward<A>(a)...);
+        }
+        template <typename E>
+        auto set_error(E&& e) && noexcept -> void {
+            this->st->complete(::beman::execution::set_error, ::std::forward<E>(e));
+        }
+        auto set_stopped() && noexcept -> void { this->st->complete(::beman::execution::set_stopped); }
+        auto get_env() const noexcept -> child_env { return {this->st}; }
+    };
+
+    struct timer_env {
+        const state* st;
+
+        auto query(const ::beman::execution::get_stop_token_t&) const noexcept
+            -> ::beman::execution::inplace_stop_token {
+            return this->st->timer_source.get_token();
+        }
+    };
+    struct timer_receiver {
+        using receiver_concept = ::beman::execution::receiver_t;
+        state* st;
+
+        auto set_value() && noexcept -> void {
+            this->st->timed_out.store(true, ::std::memory_order_release);
+            this->st->source.request_stop();
+            this->st->finish();
+        }
+        auto set_stopped() && noexcept -> void { this->st->finish(); }
+        auto get_env() const noexcept -> timer_env { return {this->st}; }
+    };
+
+    struct stop_link {
+        ::beman::execution::inplace_stop_source& source;
+        auto operator()() const noexcept -> void { this->source.request_stop(); }
+    };
+    using stop_token_t    = decltype(::beman::execution::get_stop_token(::std::declval<upstream_env>()));
+    using stop_callback_t = ::beman::execution::stop_callback_for_t<stop_token_t, stop_link>;
+    using child_state_t =
+        decltype(::beman::execution::connect(::std::declval<Sender>(), ::std::declval<child_receiver>()));
+    using timer_state_t = decltype(::beman::execution::connect(
+        ::std::declval<::beman::task::detail::timer_scheduler>().schedule_after(duration()),
+        ::std::declval<timer_receiver>()));
+
+    ::std::remove_cvref_t<Receiver>         receiver;
+    ::beman::execution::inplace_stop_source source;
+    ::beman::execution::inplace_stop_source timer_source;
+    ::std::optional<stop_callback_t>        stop_callback;
+    result_t                                result;
+    ::std::atomic<bool>                     timed_out{false};
+    ::std::atomic<::std::size_t>            remaining{2u};
+    timer_state_t                           timer;
+    child_state_t                           child;
+
+    template <typename R>
+    state(R&& r, Sender&& sndr, duration timeout, ::beman::task::detail::timer_scheduler sched)
+        : receiver(::std::forward<R>(r)),
+          timer(::beman::execution::connect(sched.schedule_after(timeout), timer_receiver{this})),
+          child(::beman::execution::connect(::std::move(sndr), child_receiver{this})) {}
+    state(const state&)            = delete;
+    state(state&&)                 = delete;
+    state& operator=(const state&) = delete;
+    state& operator=(state&&)      = delete;
+    ~state()                       = default;
+
+    auto start() & noexcept -> void {
+        this->stop_callback.emplace(::beman::execution::get_stop_token(::beman::execution::get_env(this->receiver)),
+                                    stop_link{this->source});
+        ::beman::execution::start(this->timer);
+        // The last completion delivers the result and may destroy this
+        // object: nothing may be accessed after starting the child.
+        ::beman::execution::start(this->child);
+    }
+
+    template <typename Tag, typename... A>
+    auto complete(Tag, A&&... a) noexcept -> void {
+        BEMAN_TASK_TRY {
+            this->result.template emplace<::std::tuple<Tag, ::std::decay_t<A>...>>(Tag{}, ::std::forward<A>(a)...);
+        }
+        BEMAN_TASK_CATCH_ALL {
+            this->result.template emplace<::std::tuple<::beman::execution::set_error_t, ::std::exception_ptr>>(
+                ::beman::execution::set_error, ::std::current_exception());
+        }
+        // Disarms the timer: unless it is already firing, it completes synchronously.
+        this->timer_source.request_stop();
+        this->finish();
+    }
+
+    auto finish() noexcept -> void {
+        if (1u == this->remaining.fetch_sub(1u, ::std::memory_order_acq_rel)) {
+            this->stop_callback.reset();
+            using stopped_t = ::std::tuple<::beman::execution::set_stopped_t>;
+            if (this->timed_out.load(::std::memory_order_relaxed) &&
+                ::std::holds_alternative<stopped_t>(this->result)) {
+                ::beman::execution::set_error(::std::move(this->receiver),
+                                              ::std::make_error_code(::std::errc::timed_out));
+                return;
+            }
+            ::std::visit(
+                [this]<typename T>(T& res) {
+                    if constexpr (::std::same_as<T, ::std::monostate>) {
+                        ::beman::execution::set_stopped(::std::move(this->receiver));
+                    } else {
+                        ::std::apply(
+                            [this](auto tag, auto&... arg) { tag(::std::move(this->receiver), ::std::move(arg)...); },
+                            res);
+                    }
+                },
+                this->result);
+        }
+    }
+};
+
+template <typename Sender, typename Timer>
+struct with_timeout_t::sender {
+    using sender_concept = ::beman::execution::sender_t;
+
+    Sender   sndr;
+    duration timeout;
+    Timer    timer;
+
+    template <typename Env>
+    auto get_completion_signatures(const Env&) const noexcept {
+        return with_timeout_t::completions<Env, Sender>{};
+    }
+
+    template <::beman::execution::receiver Receiver>
+    auto connect(Receiver&& receiver) && {
+        auto timer{with_timeout_t::timer_of(::beman::execution::get_env(receiver), this->timer)};
+        return with_timeout_t::state<::std::remove_cvref_t<Receiver>, Sender>(
+            ::std::forward<Receiver>(receiver), ::std::move(this->sndr), this->timeout, timer);
+    }
+};
+
+inline constexpr with_timeout_t with_timeout{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
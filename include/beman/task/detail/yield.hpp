@@ -0,0 +1,29 @@
+// include/beman/task/detail/yield.hpp                                -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_YIELD
+#define INCLUDED_INCLUDE_BEMAN_TASK_DETAIL_YIELD
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task::detail {
+/*!
+ * \brief Request to reschedule the current coroutine
+ * \headerfile beman/task/task.hpp <beman/task/task.hpp>
+ *
+ * Using `co_await yield()` in a `task` suspends the coroutine and
+ * reschedules it on its current scheduler. This way other work queued on
+ * the same scheduler can make progress during a long running stretch of
+ * code. With an `inline_scheduler` the coroutine is resumed immediately.
+ */
+struct yield_t {
+    struct request {};
+    constexpr auto operator()() const noexcept -> request { return {}; }
+};
+
+inline constexpr yield_t yield{};
+} // namespace beman::task::detail
+
+// ----------------------------------------------------------------------------
+
+#endif
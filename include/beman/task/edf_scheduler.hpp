@@ -0,0 +1,22 @@
+// include/beman/task/edf_scheduler.hpp                               -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_EDF_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_EDF_SCHEDULER
+
+#include <beman/task/detail/edf_scheduler.hpp>
+#include <beman/task/detail/get_deadline.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using get_deadline_t       = ::beman::task::detail::get_deadline_t;
+using deadline_environment = ::beman::task::detail::deadline_environment;
+using edf_context          = ::beman::task::detail::edf_context;
+using edf_scheduler        = ::beman::task::detail::edf_scheduler;
+using ::beman::task::detail::get_deadline;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
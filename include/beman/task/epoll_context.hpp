@@ -0,0 +1,24 @@
+// include/beman/task/epoll_context.hpp                               -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_EPOLL_CONTEXT
+#define INCLUDED_INCLUDE_BEMAN_TASK_EPOLL_CONTEXT
+
+#include <beman/task/detail/epoll_context.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+#ifdef BEMAN_TASK_HAS_EPOLL
+using epoll_context         = ::beman::task::detail::epoll_context;
+using epoll_scheduler       = ::beman::task::detail::epoll_scheduler;
+using async_wait_readable_t = ::beman::task::detail::async_wait_readable_t;
+using async_wait_writable_t = ::beman::task::detail::async_wait_writable_t;
+using ::beman::task::detail::async_wait_readable;
+using ::beman::task::detail::async_wait_writable;
+#endif
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,18 @@
+// include/beman/task/frame_registry.hpp                              -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_FRAME_REGISTRY
+#define INCLUDED_INCLUDE_BEMAN_TASK_FRAME_REGISTRY
+
+#include <beman/task/detail/frame_registry.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using frame_size_record = ::beman::task::detail::frame_size_record;
+using frame_registry    = ::beman::task::detail::frame_registry;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,30 @@
+// include/beman/task/io_uring_context.hpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_IO_URING_CONTEXT
+#define INCLUDED_INCLUDE_BEMAN_TASK_IO_URING_CONTEXT
+
+#include <beman/task/detail/io_uring_context.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+#ifdef BEMAN_TASK_HAS_IO_URING
+using io_uring_context   = ::beman::task::detail::io_uring_context;
+using io_uring_scheduler = ::beman::task::detail::io_uring_scheduler;
+using registered_buffer  = ::beman::task::detail::registered_buffer;
+using registered_file    = ::beman::task::detail::registered_file;
+using async_read_t       = ::beman::task::detail::async_read_t;
+using async_write_t      = ::beman::task::detail::async_write_t;
+using async_fsync_t      = ::beman::task::detail::async_fsync_t;
+using async_openat_t     = ::beman::task::detail::async_openat_t;
+using ::beman::task::detail::async_fsync;
+using ::beman::task::detail::async_openat;
+using ::beman::task::detail::async_read;
+using ::beman::task::detail::async_write;
+#endif
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
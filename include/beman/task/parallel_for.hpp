@@ -0,0 +1,20 @@
+// include/beman/task/parallel_for.hpp                                -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_PARALLEL_FOR
+#define INCLUDED_INCLUDE_BEMAN_TASK_PARALLEL_FOR
+
+#include <beman/task/detail/parallel_for.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using parallel_for_t              = ::beman::task::detail::parallel_for_t;
+using parallel_transform_reduce_t = ::beman::task::detail::parallel_transform_reduce_t;
+using ::beman::task::detail::parallel_for;
+using ::beman::task::detail::parallel_transform_reduce;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
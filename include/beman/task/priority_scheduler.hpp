@@ -0,0 +1,21 @@
+// include/beman/task/priority_scheduler.hpp                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_PRIORITY_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_PRIORITY_SCHEDULER
+
+#include <beman/task/detail/get_priority.hpp>
+#include <beman/task/detail/priority_scheduler.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using get_priority_t     = ::beman::task::detail::get_priority_t;
+using priority_context   = ::beman::task::detail::priority_context;
+using priority_scheduler = ::beman::task::detail::priority_scheduler;
+using ::beman::task::detail::get_priority;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,18 @@
+// include/beman/task/shared_task.hpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_SHARED_TASK
+#define INCLUDED_INCLUDE_BEMAN_TASK_SHARED_TASK
+
+#include <beman/task/detail/shared_task.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+template <typename T = void, typename Context = ::beman::task::detail::default_environment>
+using shared_task = ::beman::task::detail::shared_task<T, Context>;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
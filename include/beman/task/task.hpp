@@ -5,14 +5,23 @@
 #define INCLUDED_INCLUDE_BEMAN_TASK_TASK
 
 #include <beman/task/detail/allocator_of.hpp>
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/detail/extern_templates.hpp>
 #include <beman/task/detail/task_scheduler.hpp>
 #include <beman/task/detail/inline_scheduler.hpp>
 #include <beman/task/detail/into_optional.hpp>
 #include <beman/task/detail/task.hpp>
+#include <beman/task/detail/schedule_bulk.hpp>
 #include <beman/task/detail/scheduler_of.hpp>
 #include <beman/task/detail/stop_source.hpp>
+#include <beman/task/detail/trace.hpp>
+#include <beman/task/detail/yield.hpp>
 
 // ----------------------------------------------------------------------------
+// This header provides the task and what is needed to use it. Components
+// built on top of it have their own headers which need to be included
+// explicitly, e.g., <beman/task/task_scope.hpp> or
+// <beman/task/timer_scheduler.hpp>, to avoid making every user parse them.
 
 namespace beman::task {
 template <typename Context>
@@ -27,8 +36,23 @@ using inline_scheduler = ::beman::task::detail::inline_scheduler;
 using into_optional_t  = ::beman::task::detail::into_optional_t;
 using ::beman::task::detail::into_optional;
 
+using as_expected_t = ::beman::task::detail::as_expected_t;
+using ::beman::task::detail::as_expected;
+
+using schedule_bulk_t = ::beman::task::detail::schedule_bulk_t;
+using ::beman::task::detail::schedule_bulk;
+
 using ::beman::task::detail::change_coroutine_scheduler;
 using ::beman::task::detail::with_error;
+
+using failure_handler = ::beman::task::detail::failure_handler;
+using ::beman::task::detail::set_failure_handler;
+
+using trace_handler = ::beman::task::detail::trace_handler;
+using ::beman::task::detail::set_trace_handler;
+
+using yield_t = ::beman::task::detail::yield_t;
+using ::beman::task::detail::yield;
 } // namespace beman::task
 
 namespace beman::execution {
@@ -0,0 +1,21 @@
+// include/beman/task/task_scope.hpp                                  -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_TASK_SCOPE
+#define INCLUDED_INCLUDE_BEMAN_TASK_TASK_SCOPE
+
+#include <beman/task/detached_task.hpp>
+#include <beman/task/detail/task_scope.hpp>
+#include <cstddef>
+#include <memory>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+template <typename Allocator = ::std::allocator<::std::byte>>
+using task_scope = ::beman::task::detail::task_scope<Allocator>;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,24 @@
+// include/beman/task/timer_scheduler.hpp                             -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_TIMER_SCHEDULER
+#define INCLUDED_INCLUDE_BEMAN_TASK_TIMER_SCHEDULER
+
+#include <beman/task/detail/timer_scheduler.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using timer_context         = ::beman::task::detail::timer_context;
+using timer_scheduler       = ::beman::task::detail::timer_scheduler;
+using schedule_at_t         = ::beman::task::detail::schedule_at_t;
+using schedule_after_t      = ::beman::task::detail::schedule_after_t;
+using get_timer_scheduler_t = ::beman::task::detail::get_timer_scheduler_t;
+using ::beman::task::detail::get_timer_scheduler;
+using ::beman::task::detail::schedule_after;
+using ::beman::task::detail::schedule_at;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
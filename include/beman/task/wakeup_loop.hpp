@@ -0,0 +1,21 @@
+// include/beman/task/wakeup_loop.hpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_WAKEUP_LOOP
+#define INCLUDED_INCLUDE_BEMAN_TASK_WAKEUP_LOOP
+
+#include <beman/task/detail/eventfd_wakeup.hpp>
+#include <beman/task/detail/wakeup_loop.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+#ifdef BEMAN_TASK_HAS_EVENTFD
+using eventfd_wakeup = ::beman::task::detail::eventfd_wakeup;
+using wakeup_loop    = ::beman::task::detail::wakeup_loop;
+#endif
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,18 @@
+// include/beman/task/when_any.hpp                                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_WHEN_ANY
+#define INCLUDED_INCLUDE_BEMAN_TASK_WHEN_ANY
+
+#include <beman/task/detail/when_any.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using when_any_t = ::beman::task::detail::when_any_t;
+using ::beman::task::detail::when_any;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,19 @@
+// include/beman/task/with_timeout.hpp                                -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef INCLUDED_INCLUDE_BEMAN_TASK_WITH_TIMEOUT
+#define INCLUDED_INCLUDE_BEMAN_TASK_WITH_TIMEOUT
+
+#include <beman/task/detail/with_timeout.hpp>
+#include <beman/task/timer_scheduler.hpp>
+
+// ----------------------------------------------------------------------------
+
+namespace beman::task {
+using with_timeout_t = ::beman::task::detail::with_timeout_t;
+using ::beman::task::detail::with_timeout;
+} // namespace beman::task
+
+// ----------------------------------------------------------------------------
+
+#endif
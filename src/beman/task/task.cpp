@@ -1,4 +1,6 @@
 // src/beman/task/task.cpp                                            -*-C++-*-
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+// Turn the extern template declarations into explicit instantiations.
+#define BEMAN_TASK_EXTERN_TEMPLATE
 #include <beman/task/task.hpp>
@@ -4,6 +4,8 @@
 #include <beman/task/detail/affine_on.hpp>
 #include <beman/task/detail/single_thread_context.hpp>
 #include <beman/execution/execution.hpp>
+#include <type_traits>
+#include <utility>
 #ifdef NDEBUG
 #undef NDEBUG
 #endif
@@ -22,6 +24,91 @@ struct receiver {
     void set_stopped() && noexcept {}
 };
 static_assert(ex::receiver<receiver>);
+
+// Scheduler completing inline which counts the started schedule operations.
+struct counting_scheduler {
+    using scheduler_concept = ex::scheduler_t;
+    int  id;
+    int* count;
+
+    struct env {
+        int  id;
+        int* count;
+        template <typename Tag>
+        auto query(const ex::get_completion_scheduler_t<Tag>&) const noexcept {
+            return counting_scheduler{this->id, this->count};
+        }
+    };
+    template <ex::receiver Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        std::remove_cvref_t<Receiver> receiver;
+        int*                          count;
+        void                          start() & noexcept {
+            ++*this->count;
+            ex::set_value(std::move(this->receiver));
+        }
+    };
+    struct sender {
+        using sender_concept        = ex::sender_t;
+        using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+        int  id;
+        int* count;
+
+        template <ex::receiver Receiver>
+        auto connect(Receiver&& r) const -> state<Receiver> {
+            return {std::forward<Receiver>(r), this->count};
+        }
+        auto get_env() const noexcept -> env { return {this->id, this->count}; }
+    };
+
+    auto schedule() const noexcept -> sender { return {this->id, this->count}; }
+    auto operator==(const counting_scheduler& other) const -> bool { return this->id == other.id; }
+};
+static_assert(ex::scheduler<counting_scheduler>);
+
+auto test_elided_schedule() {
+    int                count{};
+    counting_scheduler sched{0, &count};
+    int                other_count{};
+    counting_scheduler other{1, &other_count};
+
+    // completing on the target scheduler already: no reschedule
+    ex::sync_wait(beman::task::affine_on(sched.schedule(), sched));
+    assert(count == 1);
+
+    // completing on another scheduler: rescheduled
+    ex::sync_wait(beman::task::affine_on(other.schedule(), sched));
+    assert(other_count == 1);
+    assert(count == 2);
+}
+
+auto test_skip() {
+    int                count{};
+    counting_scheduler sched{0, &count};
+    int                other_count{};
+    counting_scheduler other{1, &other_count};
+    int                calls{};
+    bool               possible{};
+
+    // the reschedule is only skipped if `skip` agrees
+    auto refuse{[&calls, &possible](bool p) {
+        ++calls;
+        possible = p;
+        return false;
+    }};
+    ex::sync_wait(beman::task::affine_on(sched.schedule(), sched, refuse));
+    assert(calls == 1);
+    assert(possible);
+    assert(count == 2);
+
+    // `skip` is told when the reschedule can't be skipped
+    ex::sync_wait(beman::task::affine_on(other.schedule(), sched, refuse));
+    assert(calls == 2);
+    assert(not possible);
+    assert(other_count == 1);
+    assert(count == 3);
+}
 } // namespace
 
 int main() {
@@ -46,4 +133,7 @@ int main() {
                         assert(thread_id == std::this_thread::get_id());
                         assert(value == 42);
                     }));
+
+    test_elided_schedule();
+    test_skip();
 }
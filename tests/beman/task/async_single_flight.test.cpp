@@ -0,0 +1,219 @@
+// tests/beman/task/async_single_flight.test.cpp                      -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/async_single_flight.hpp>
+#include <beman/task/detail/async_single_flight.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+// A sender completing when the gate gets opened.
+struct gate {
+    struct base {
+        virtual void fire() noexcept = 0;
+
+      protected:
+        ~base() = default;
+    };
+    base* waiting{};
+
+    struct sender {
+        using sender_concept        = ex::sender_t;
+        using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+        gate* g;
+
+        template <ex::receiver Receiver>
+        struct state : base {
+            using operation_state_concept = ex::operation_state_t;
+            std::remove_cvref_t<Receiver> receiver;
+            gate*                         g;
+            state(Receiver&& r, gate* g) : receiver(std::forward<Receiver>(r)), g(g) {}
+            void                          start() & noexcept { this->g->waiting = this; }
+            void                          fire() noexcept override { ex::set_value(std::move(this->receiver)); }
+        };
+        template <ex::receiver Receiver>
+        auto connect(Receiver&& receiver) && {
+            return state<Receiver>(std::forward<Receiver>(receiver), this->g);
+        }
+    };
+    auto wait() { return sender{this}; }
+    void open() {
+        if (base* w{std::exchange(this->waiting, nullptr)}) {
+            w->fire();
+        }
+    }
+};
+
+struct receiver {
+    using receiver_concept = ex::receiver_t;
+    struct env {
+        ex::inplace_stop_token token;
+        auto                   query(const ex::get_stop_token_t&) const noexcept { return this->token; }
+    };
+    ex::inplace_stop_token token;
+    int*                   result;
+
+    void set_value(int value) && noexcept { *this->result = value; }
+    void set_error(auto&&) && noexcept { *this->result = -1; }
+    void set_stopped() && noexcept { *this->result = -2; }
+    auto get_env() const noexcept { return env{this->token}; }
+};
+
+auto test_coalescing() {
+    gate                              g;
+    int                               loads{0};
+    bt::async_single_flight<int, int> flight(bt::inline_scheduler(), [&](const int& key) -> ex::task<int> {
+        ++loads;
+        co_await g.wait();
+        co_return 2 * key;
+    });
+    auto rc{ex::sync_wait(ex::when_all(flight.get(17), flight.get(17), ex::just() | ex::then([&] { g.open(); })))};
+    assert(rc);
+    [[maybe_unused]] auto [v0, v1] = *rc;
+    assert(v0 == 34);
+    assert(v1 == 34);
+    assert(loads == 1);
+}
+
+auto test_cancel() {
+    gate                              g;
+    int                               loads{0};
+    bool                              stop_seen{false};
+    bt::async_single_flight<int, int> flight(bt::inline_scheduler(), [&](const int& key) -> ex::task<int> {
+        ++loads;
+        co_await g.wait();
+        stop_seen = (co_await ex::read_env(ex::get_stop_token)).stop_requested();
+        co_return key;
+    });
+
+    ex::inplace_stop_source source;
+    int                     result{0};
+    auto                    op{ex::connect(flight.get(17), receiver{source.get_token(), &result})};
+    ex::start(op);
+    assert(result == 0);
+    assert(loads == 1);
+    source.request_stop();
+    assert(result == -2);
+    g.open();
+    assert(stop_seen);
+
+    // the abandoned load isn't reused
+    ex::inplace_stop_source other;
+    int                     value{0};
+    auto                    op2{ex::connect(flight.get(17), receiver{other.get_token(), &value})};
+    ex::start(op2);
+    assert(loads == 2);
+    g.open();
+    assert(value == 17);
+}
+
+auto test_cache() {
+    int                               loads{0};
+    bt::async_single_flight<int, int> uncached(bt::inline_scheduler(), [&](const int& key) -> ex::task<int> {
+        ++loads;
+        co_return key;
+    });
+    ex::sync_wait(uncached.get(1));
+    ex::sync_wait(uncached.get(1));
+    assert(loads == 2);
+
+    loads = 0;
+    bt::async_single_flight<int, int> cached(
+        bt::inline_scheduler(),
+        [&](const int& key) -> ex::task<int> {
+            ++loads;
+            co_return key;
+        },
+        std::chrono::hours(1));
+    auto [v0]{*ex::sync_wait(cached.get(1))};
+    auto [v1]{*ex::sync_wait(cached.get(1))};
+    assert(v0 == 1 && v1 == 1);
+    assert(loads == 1);
+    cached.clear_cache();
+    ex::sync_wait(cached.get(1));
+    assert(loads == 2);
+}
+
+auto test_cache_pruning() {
+    bt::async_single_flight<int, int> flight(
+        bt::inline_scheduler(), [](const int& key) -> ex::task<int> { co_return key; }, std::chrono::nanoseconds(1));
+    // the values expire immediately: each key is requested only once
+    for (int key{0}; key != 10000; ++key) {
+        ex::sync_wait(flight.get(key));
+    }
+    // expired values are removed when a shard's cache reaches 16 entries
+    assert((flight.cache_size() <= 16u * bt::async_single_flight<int, int>::shard_count));
+    flight.clear_cache();
+    assert(flight.cache_size() == 0u);
+}
+
+auto test_error() {
+    bt::async_single_flight<int, int> flight(bt::inline_scheduler(), [](const int&) -> ex::task<int> {
+        throw std::runtime_error("load failed");
+        co_return 0;
+    });
+    try {
+        ex::sync_wait(flight.get(1));
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+}
+
+// All keys end up in the same shard.
+struct same_shard {
+    auto operator()(int) const noexcept -> std::size_t { return 0u; }
+};
+
+auto test_reentrant_loader() {
+    using flight_t = bt::async_single_flight<int, int, bt::detail::default_environment, same_shard>;
+    flight_t* self{};
+    int       loads{0};
+    flight_t  flight(bt::inline_scheduler(), [&](const int& key) -> ex::task<int> {
+        ++loads;
+        // the loader itself requests another key of the same shard
+        int previous{key == 0 ? 0 : std::get<0>(*ex::sync_wait(self->get(key - 1)))};
+        return [](int value) -> ex::task<int> { co_return value; }(previous + key);
+    });
+    self = &flight;
+    auto [value]{*ex::sync_wait(flight.get(4))};
+    assert(value == 4 + 3 + 2 + 1);
+    assert(loads == 5);
+}
+
+auto test_throwing_loader() {
+    bt::async_single_flight<int, int> flight(bt::inline_scheduler(), [](const int&) -> ex::task<int> {
+        throw std::runtime_error("no task");
+    });
+    for (int i{0}; i != 2; ++i) {
+        try {
+            ex::sync_wait(flight.get(1));
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+}
+} // namespace
+
+int main() {
+    test_coalescing();
+    test_cancel();
+    test_cache();
+    test_cache_pruning();
+    test_error();
+    test_reentrant_loader();
+    test_throwing_loader();
+}
@@ -0,0 +1,73 @@
+// tests/beman/task/await_elision.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// The number of allocations for a chain of immediately awaited tasks
+// depends on the compiler: with [[clang::coro_await_elidable]] support the
+// frames of awaited tasks can be placed into the frame of the awaiting
+// task. The count is reported to track the effect per compiler.
+
+namespace {
+std::atomic<std::size_t> allocations{};
+
+constexpr int depth{5};
+
+auto chain(int level) -> ex::task<int> {
+    if (level == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await chain(level - 1);
+}
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+    ++allocations;
+    if (void* ptr{std::malloc(size ? size : 1u)}) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+auto operator delete(void* ptr) noexcept -> void { std::free(ptr); }
+auto operator delete(void* ptr, std::size_t) noexcept -> void { std::free(ptr); }
+
+int main() {
+    // warm up anything allocated once, e.g., by the run_loop of sync_wait
+    ex::sync_wait(chain(depth));
+
+    std::size_t before{allocations.load()};
+    auto        result{ex::sync_wait(chain(depth))};
+    std::size_t count{allocations.load() - before};
+    assert(result);
+    assert(std::get<0>(*result) == depth);
+
+#ifndef BEMAN_TASK_FRAME_SIZE_REGISTRY
+    // at most one frame per level plus the outermost task; the frame
+    // registry allocates its own bookkeeping for each frame
+    assert(count <= std::size_t(depth + 1));
+#endif
+    std::cout << "allocations for a depth-" << depth << " chain of awaited tasks: " << count
+#ifdef __clang__
+              << " (clang " << __clang_major__ << ")"
+#elif defined(__GNUC__)
+              << " (gcc " << __GNUC__ << ")"
+#endif
+#if __has_cpp_attribute(clang::coro_await_elidable)
+              << ", coro_await_elidable supported"
+#endif
+              << "\n";
+}
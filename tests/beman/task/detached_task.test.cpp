@@ -0,0 +1,87 @@
+// tests/beman/task/detached_task.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detached_task.hpp>
+#include <beman/task/detail/detached_task.hpp>
+#include <beman/task/detail/single_thread_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/task_scope.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <thread>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+auto child(int value) -> ex::task<int> { co_return value; }
+
+auto run(auto, bt::task_scope<>&, std::thread::id id, std::atomic<int>& sum) -> bt::detached_task<> {
+    // the coroutine starts on the scheduler's thread
+    assert(id == std::this_thread::get_id());
+    sum += co_await child(1);
+    sum += co_await ex::just(2);
+}
+
+auto test_scope() {
+    beman::task::detail::single_thread_context context;
+    std::thread::id                            id{};
+    ex::sync_wait(ex::schedule(context.get_scheduler()) | ex::then([&id] { id = std::this_thread::get_id(); }));
+    bt::task_scope<> scope;
+    std::atomic<int> sum{};
+    for (int i{}; i != 100; ++i) {
+        run(context.get_scheduler(), scope, id, sum);
+    }
+    ex::sync_wait(scope.join());
+    assert(sum == 300);
+}
+
+auto stopped(bt::inline_scheduler, bt::task_scope<>&, bool& done) -> bt::detached_task<> {
+    co_await ex::just_stopped();
+    done = true;
+}
+
+auto test_stopped() {
+    bt::task_scope<> scope;
+    bool             done{};
+    stopped(bt::inline_scheduler{}, scope, done);
+    ex::sync_wait(scope.join());
+    assert(not done);
+}
+
+auto observe(bt::inline_scheduler, bt::task_scope<>&, bool& requested) -> bt::detached_task<> {
+    requested = (co_await ex::read_env(ex::get_stop_token)).stop_requested();
+}
+
+auto test_stop_token() {
+    bt::task_scope<> scope;
+    bool             requested{};
+    scope.request_stop();
+    observe(bt::inline_scheduler{}, scope, requested);
+    ex::sync_wait(scope.join());
+    assert(requested);
+}
+
+auto unscoped(bt::inline_scheduler, int& value) -> bt::detached_task<> {
+    value = co_await child(17);
+}
+
+auto test_unscoped() {
+    int value{};
+    unscoped(bt::inline_scheduler{}, value);
+    assert(value == 17);
+}
+} // namespace
+
+int main() {
+    test_scope();
+    test_stopped();
+    test_stop_token();
+    test_unscoped();
+}
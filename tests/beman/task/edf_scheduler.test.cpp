@@ -0,0 +1,131 @@
+// tests/beman/task/edf_scheduler.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/edf_scheduler.hpp>
+#include <beman/task/edf_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <latch>
+#include <mutex>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct recorder {
+    std::mutex               mutex;
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> expired;
+    void                     add(std::vector<std::size_t>& to, std::size_t id) {
+        std::lock_guard guard(this->mutex);
+        to.push_back(id);
+    }
+};
+
+struct no_env {};
+
+template <typename Env = no_env>
+struct record_receiver {
+    using receiver_concept = ex::receiver_t;
+    recorder*   rec;
+    std::size_t id;
+    std::latch* done;
+    Env         env{};
+
+    void set_value() && noexcept {
+        this->rec->add(this->rec->order, this->id);
+        this->done->count_down();
+    }
+    void set_error(auto&&) && noexcept { assert(false); }
+    void set_stopped() && noexcept {
+        this->rec->add(this->rec->expired, this->id);
+        this->done->count_down();
+    }
+    auto get_env() const noexcept { return this->env; }
+};
+
+using deadline_receiver = record_receiver<bt::deadline_environment>;
+
+// The scheduler is obtained from the context by Wrap, e.g., to test the
+// deadline is also honored when scheduling through a task_scheduler.
+template <typename Wrap>
+auto test_order(Wrap wrap) {
+    bt::edf_context    context(1u);
+    auto               sched{wrap(context.get_scheduler())};
+    recorder           rec;
+    std::promise<void> started;
+    std::promise<void> release;
+    std::latch         done{6};
+    auto               now{clock_type::now()};
+
+    // keep the only worker busy until all work is queued
+    auto blocker{ex::connect(ex::schedule(sched) | ex::then([&] {
+                                 started.set_value();
+                                 release.get_future().wait();
+                             }),
+                             record_receiver<>{&rec, 99u, &done})};
+    ex::start(blocker);
+    started.get_future().wait();
+
+    auto op0{ex::connect(ex::schedule(sched), record_receiver<>{&rec, 0u, &done})};
+    auto op1{ex::connect(ex::schedule(sched),
+                         deadline_receiver{&rec, 1u, &done, bt::deadline_environment(now + std::chrono::hours(2))})};
+    auto op2{ex::connect(ex::schedule(sched),
+                         deadline_receiver{&rec, 2u, &done, bt::deadline_environment(now + std::chrono::hours(1))})};
+    auto op3{ex::connect(ex::schedule(sched),
+                         deadline_receiver{&rec, 3u, &done, bt::deadline_environment(now + std::chrono::hours(1))})};
+    // work whose deadline passed while it was queued isn't run
+    auto op4{ex::connect(ex::schedule(sched), deadline_receiver{&rec, 4u, &done, bt::deadline_environment(now)})};
+    ex::start(op0);
+    ex::start(op1);
+    ex::start(op2);
+    ex::start(op3);
+    ex::start(op4);
+    release.set_value();
+    done.wait();
+
+    assert((rec.order == std::vector<std::size_t>{99u, 2u, 3u, 1u, 0u}));
+    assert((rec.expired == std::vector<std::size_t>{4u}));
+}
+
+auto test_task() {
+    bt::edf_context context(2u);
+    auto            deadline{clock_type::now() + std::chrono::hours(1)};
+
+    auto inner{[]() -> ex::task<clock_type::time_point, bt::deadline_environment> {
+        co_return co_await ex::read_env(bt::get_deadline);
+    }};
+    auto outer{[&inner]() -> ex::task<std::vector<clock_type::time_point>, bt::deadline_environment> {
+        co_await ex::just();
+        // the nested task inherits the deadline of the awaiting task
+        auto own{co_await ex::read_env(bt::get_deadline)};
+        auto nested{co_await inner()};
+        co_return std::vector<clock_type::time_point>{own, nested};
+    }};
+
+    auto [result]{*ex::sync_wait(ex::detail::write_env(ex::starts_on(context.get_scheduler(), outer()),
+                                                       ex::detail::make_env(bt::get_deadline, deadline)))};
+    assert((result == std::vector<clock_type::time_point>{deadline, deadline}));
+
+    auto [none]{*ex::sync_wait(ex::starts_on(context.get_scheduler(), inner()))};
+    assert(none == clock_type::time_point::max());
+}
+} // namespace
+
+int main() {
+    test_order([](bt::edf_scheduler sched) { return sched; });
+    test_order([](bt::edf_scheduler sched) { return bt::task_scheduler(sched); });
+    test_task();
+}
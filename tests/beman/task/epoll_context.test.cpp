@@ -0,0 +1,142 @@
+// tests/beman/task/epoll_context.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/epoll_context.hpp>
+#include <beman/task/epoll_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+#ifdef BEMAN_TASK_HAS_EPOLL
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+auto test_pipe(bt::epoll_context& context) {
+    int fds[2];
+    assert(::pipe2(fds, O_NONBLOCK) == 0);
+    std::thread writer([fd = fds[1]] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(::write(fd, "x", 1u) == 1);
+    });
+    ex::sync_wait([](auto sched, int in, int out) -> ex::task<> {
+        // a pipe is writable right away
+        co_await bt::async_wait_writable(sched, out);
+        char c{};
+        while (::read(in, &c, 1u) < 0) {
+            assert(errno == EAGAIN);
+            co_await bt::async_wait_readable(sched, in);
+        }
+        assert(c == 'x');
+    }(context.get_scheduler(), fds[0], fds[1]));
+    writer.join();
+    context.deregister(fds[0]);
+    context.deregister(fds[1]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+auto test_reactor_thread(bt::epoll_context& context) {
+    int fd{::eventfd(0u, EFD_NONBLOCK)};
+    assert(0 <= fd);
+    std::thread writer([fd] {
+        for (int i{}; i != 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::uint64_t one{1u};
+            assert(::write(fd, &one, sizeof(one)) == sizeof(one));
+        }
+    });
+    ex::sync_wait([](auto sched, int efd) -> ex::task<> {
+        co_await ex::change_coroutine_scheduler(sched);
+        co_await ex::schedule(sched);
+        auto          id{std::this_thread::get_id()};
+        std::uint64_t total{};
+        while (total != 3u) {
+            std::uint64_t value{};
+            if (::read(efd, &value, sizeof(value)) < 0) {
+                assert(errno == EAGAIN);
+                co_await bt::async_wait_readable(sched, efd);
+                // the task is resumed on the reactor's thread
+                assert(id == std::this_thread::get_id());
+            } else {
+                total += value;
+            }
+        }
+    }(context.get_scheduler(), fd));
+    writer.join();
+    context.deregister(fd);
+    ::close(fd);
+}
+
+auto test_cancel(bt::epoll_context& context) {
+    int fds[2];
+    assert(::pipe2(fds, O_NONBLOCK) == 0);
+    ex::inplace_stop_source source;
+    std::thread             stopper([&source] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        source.request_stop();
+    });
+    // nothing is ever written to the pipe
+    auto rc{ex::sync_wait(ex::detail::write_env(bt::async_wait_readable(context.get_scheduler(), fds[0]),
+                                                ex::detail::make_env(ex::get_stop_token, source.get_token())))};
+    assert(not rc);
+    stopper.join();
+    context.deregister(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+auto test_error(bt::epoll_context& context) {
+    ex::sync_wait([](auto sched) -> ex::task<> {
+        try {
+            co_await bt::async_wait_readable(sched, -1);
+            assert(false);
+        } catch (const std::system_error& error) {
+            assert(error.code().value() == EBADF);
+        }
+    }(context.get_scheduler()));
+}
+
+auto test_schedule(bt::epoll_context& context) {
+    std::vector<std::thread> threads;
+    for (int t{}; t != 8; ++t) {
+        threads.emplace_back([&context] {
+            for (int i{}; i != 100; ++i) {
+                ex::sync_wait(ex::schedule(context.get_scheduler()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+} // namespace
+
+int main() {
+    bt::epoll_context context;
+    test_pipe(context);
+    test_reactor_thread(context);
+    test_cancel(context);
+    test_error(context);
+    test_schedule(context);
+}
+#else
+int main() { std::cout << "epoll isn't available on this platform\n"; }
+#endif
@@ -0,0 +1,62 @@
+// tests/beman/task/eventfd_wakeup.test.cpp                           -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/eventfd_wakeup.hpp>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+// ----------------------------------------------------------------------------
+
+#ifdef BEMAN_TASK_HAS_EVENTFD
+#include <unistd.h>
+
+namespace {
+auto test_coalesce() {
+    beman::task::detail::eventfd_wakeup wakeup;
+    // notifications while the consumer is awake don't touch the eventfd
+    wakeup.notify();
+    wakeup.notify();
+    std::uint64_t count{};
+    assert(::read(wakeup.native_handle(), &count, sizeof(count)) < 0 && errno == EAGAIN);
+    // ... but the pending notification prevents blocking
+    assert(not wakeup.prepare_wait());
+    assert(wakeup.prepare_wait());
+    wakeup.woken();
+}
+
+auto test_wait() {
+    beman::task::detail::eventfd_wakeup wakeup;
+    std::atomic<bool>                   ready{false};
+    assert(wakeup.prepare_wait());
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ready = true;
+        wakeup.notify();
+    });
+    wakeup.wait();
+    assert(ready);
+    producer.join();
+
+    // the eventfd was reset: the next wait blocks until notified again
+    assert(wakeup.prepare_wait());
+    wakeup.woken();
+    std::uint64_t count{};
+    assert(::read(wakeup.native_handle(), &count, sizeof(count)) < 0 && errno == EAGAIN);
+}
+} // namespace
+
+int main() {
+    test_coalesce();
+    test_wait();
+}
+#else
+int main() { std::cout << "eventfd isn't available on this platform\n"; }
+#endif
@@ -0,0 +1,106 @@
+// tests/beman/task/forward_errors_of.test.cpp                        -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/forward_errors_of.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <system_error>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct default_context {};
+template <bool Forward>
+struct error_context {
+    using scheduler_type = bt::inline_scheduler;
+    using error_types    = ex::completion_signatures<ex::set_error_t(std::error_code)>;
+    static constexpr bool forward_errors{Forward};
+};
+struct exception_context {
+    using scheduler_type = bt::inline_scheduler;
+    static constexpr bool forward_errors{true};
+};
+
+template <typename Context>
+auto leaf(bool fail) -> ex::task<int, Context> {
+    if (fail) {
+        co_yield bt::with_error(std::make_error_code(std::errc::io_error));
+    }
+    co_return 17;
+}
+
+template <typename Context>
+auto parent(bool fail, bool& caught, bool& resumed) -> ex::task<int, Context> {
+    int value{-1};
+    try {
+        value   = co_await leaf<Context>(fail);
+        resumed = true;
+    } catch (const std::error_code&) {
+        caught = true;
+    }
+    co_return value;
+}
+
+template <typename Context>
+auto run(bool fail, bool& caught, bool& resumed) -> int {
+    auto result{ex::sync_wait(parent<Context>(fail, caught, resumed) |
+                              ex::upon_error([](auto) { return -1; }))};
+    assert(result);
+    return std::get<0>(*result);
+}
+
+auto test_forward() {
+    bool caught{}, resumed{};
+    assert(run<error_context<true>>(true, caught, resumed) == -1);
+    // the error is passed on without resuming the parent
+    assert(not caught);
+    assert(not resumed);
+    assert(run<error_context<true>>(false, caught, resumed) == 17);
+    assert(resumed);
+}
+
+auto test_throw() {
+    bool caught{}, resumed{};
+    assert(run<error_context<false>>(true, caught, resumed) == -1);
+    assert(caught);
+    assert(not resumed);
+}
+
+auto test_exception_ptr() {
+    bool caught{}, resumed{};
+    try {
+        ex::sync_wait([](bool& c) -> ex::task<void, exception_context> {
+            try {
+                co_await []() -> ex::task<void, exception_context> {
+                    throw 17;
+                    co_return;
+                }();
+            } catch (int) {
+                // exceptions are always rethrown in the parent
+                c = true;
+            }
+        }(caught));
+    } catch (...) {
+        resumed = true;
+    }
+    assert(caught);
+    assert(not resumed);
+}
+} // namespace
+
+int main() {
+    static_assert(not bt::detail::forward_errors_of_v<default_context>);
+    static_assert(not bt::detail::forward_errors_of_v<error_context<false>>);
+    static_assert(bt::detail::forward_errors_of_v<error_context<true>>);
+
+    test_forward();
+    test_throw();
+    test_exception_ptr();
+}
@@ -0,0 +1,111 @@
+// tests/beman/task/frame_cache.test.cpp                              -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/frame_cache.hpp>
+#include <beman/task/detail/recycle_frames_of.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct counting_resource : std::pmr::memory_resource {
+    std::size_t allocations{};
+    std::size_t outstanding{};
+
+    void* do_allocate(std::size_t size, std::size_t) override {
+        ++this->allocations;
+        this->outstanding += size;
+        return ::operator new(size);
+    }
+    void do_deallocate(void* ptr, std::size_t size, std::size_t) override {
+        ::operator delete(ptr);
+        this->outstanding -= size;
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+struct plain_context {
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    using scheduler_type = bt::inline_scheduler;
+};
+struct recycling_context : plain_context {
+    static constexpr bool recycle_frames{true};
+};
+
+int releases{};
+
+auto test_cache() {
+    static int memory[2];
+    bt::detail::frame_cache::release_t release{[](void*, std::size_t) noexcept { ++releases; }};
+    {
+        bt::detail::frame_cache cache;
+        assert(not cache.holds(sizeof(int), release));
+        assert(cache.put(&memory[0], sizeof(int), release));
+        assert(not cache.put(&memory[1], sizeof(int), release));
+        assert(cache.holds(sizeof(int), release));
+        assert(not cache.holds(2u * sizeof(int), release));
+        assert(cache.take() == &memory[0]);
+        assert(not cache.holds(sizeof(int), release));
+        assert(cache.put(&memory[1], sizeof(int), release));
+        assert(releases == 0);
+    }
+    // the memory still held is released when the cache is destroyed
+    assert(releases == 1);
+    assert(bt::detail::frame_cache::current() == nullptr);
+}
+
+template <typename Context>
+auto child(std::allocator_arg_t, std::pmr::polymorphic_allocator<std::byte>, int value) -> ex::task<int, Context> {
+    co_return value;
+}
+
+template <typename Context, typename ChildContext>
+auto parent(std::allocator_arg_t, std::pmr::polymorphic_allocator<std::byte> alloc, int count)
+    -> ex::task<int, Context> {
+    int sum{};
+    for (int i{}; i != count; ++i) {
+        // not immediately awaited: the frame isn't elided
+        auto t{child<ChildContext>(std::allocator_arg, alloc, i)};
+        sum += co_await std::move(t);
+    }
+    co_return sum;
+}
+
+template <typename Context, typename ChildContext = Context>
+auto allocations(int count) -> std::size_t {
+    counting_resource resource;
+    auto              result{ex::sync_wait(parent<Context, ChildContext>(std::allocator_arg, &resource, count))};
+    assert(result);
+    assert(std::get<0>(*result) == count * (count - 1) / 2);
+    // all memory, including the memory kept in the cache, is released
+    assert(resource.outstanding == 0u);
+    return resource.allocations;
+}
+} // namespace
+
+int main() {
+    static_assert(not bt::detail::recycle_frames_of_v<plain_context>);
+    static_assert(bt::detail::recycle_frames_of_v<recycling_context>);
+
+    test_cache();
+
+    // one frame for the parent plus one frame for each child
+    assert(allocations<plain_context>(10) == 11u);
+    // one frame for the parent plus one frame reused for all children
+    assert(allocations<recycling_context>(10) == 2u);
+    // only children opting into recycling use the parent's cache
+    assert((allocations<recycling_context, plain_context>(10) == 11u));
+    assert(bt::detail::frame_cache::current() == nullptr);
+}
@@ -0,0 +1,116 @@
+// tests/beman/task/frame_registry.test.cpp                           -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TASK_FRAME_SIZE_REGISTRY
+#define BEMAN_TASK_FRAME_SIZE_REGISTRY
+#endif
+
+#include <beman/task/detail/frame_registry.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+auto find(const std::vector<bt::detail::frame_size_record>& records, std::uint_least32_t line, std::size_t size)
+    -> const bt::detail::frame_size_record* {
+    for (const auto& r : records) {
+        if (r.location.line() == line && r.size == size) {
+            return &r;
+        }
+    }
+    return nullptr;
+}
+
+auto test_record() {
+    bt::detail::frame_registry registry;
+    const std::source_location a{std::source_location::current()};
+    const std::source_location b{std::source_location::current()};
+    registry.record(a, 128u);
+    registry.record(b, 64u);
+    registry.record(a, 128u);
+    registry.record(a, 256u);
+    auto records{registry.records()};
+    assert(records.size() == 3u);
+    assert(find(records, a.line(), 128u) && find(records, a.line(), 128u)->count == 2u);
+    assert(find(records, b.line(), 64u) && find(records, b.line(), 64u)->count == 1u);
+    assert(find(records, a.line(), 256u) && find(records, a.line(), 256u)->count == 1u);
+
+    std::FILE* file{std::tmpfile()};
+    assert(file);
+    registry.dump(file);
+    std::rewind(file);
+    const std::string expected{"128\t2\t" + std::string(a.file_name()) + ":" + std::to_string(a.line()) + "\t" +
+                               a.function_name() + "\n"};
+    bool found{};
+    char line[1024];
+    while (std::fgets(line, sizeof(line), file)) {
+        found = found || std::string_view(line) == expected;
+    }
+    assert(found);
+    std::fclose(file);
+
+    registry.clear();
+    assert(registry.records().empty());
+}
+
+auto test_identify() {
+    bt::detail::frame_registry registry;
+    int                        frames[3]{};
+    const std::source_location location{std::source_location::current()};
+
+    // a frame is recorded once its promise identifies it...
+    registry.allocated(&frames[0], 32u);
+    assert(registry.records().empty());
+    registry.identify(&frames[0], location);
+    registry.deallocated(&frames[0]);
+    // ... or, without identification, when it is released
+    registry.allocated(&frames[1], 16u);
+    registry.deallocated(&frames[1]);
+    // the memory of a released frame may be reused
+    registry.allocated(&frames[0], 32u);
+    registry.identify(&frames[0], location);
+
+    auto records{registry.records()};
+    assert(records.size() == 2u);
+    assert(find(records, location.line(), 32u) && find(records, location.line(), 32u)->count == 2u);
+    assert(find(records, 0u, 16u) && find(records, 0u, 16u)->count == 1u);
+}
+
+auto work(int value) -> ex::task<int> { co_return value; }
+
+auto test_frames() {
+    bt::detail::frame_registry& registry{bt::detail::frame_registry::instance()};
+    registry.clear();
+    for (int i{}; i != 3; ++i) {
+        ex::sync_wait(work(i));
+    }
+    auto records{registry.records()};
+    assert(records.size() == 1u);
+    assert(records[0].count == 3u);
+    assert(records[0].size != 0u);
+    // the location identifies the coroutine
+    assert(std::string_view(records[0].location.function_name()).find("work") != std::string_view::npos);
+    assert(std::string_view(records[0].location.file_name()).find("frame_registry.test") != std::string_view::npos);
+}
+} // namespace
+
+int main() {
+    test_record();
+    test_identify();
+    test_frames();
+}
@@ -0,0 +1,81 @@
+// tests/beman/task/into_optional.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/into_optional.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <concepts>
+#include <expected>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <variant>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct error_context {
+    using error_types = ex::completion_signatures<ex::set_error_t(std::error_code)>;
+};
+
+auto fail(bool failed) -> ex::task<int, error_context> {
+    if (failed) {
+        co_yield bt::with_error(std::make_error_code(std::errc::io_error));
+    }
+    co_return 17;
+}
+
+auto test_into_optional() {
+    auto value{ex::sync_wait(bt::into_optional(ex::just(17)))};
+    assert(value);
+    std::same_as<std::optional<int>> auto opt{std::get<0>(*value)};
+    assert(opt == 17);
+}
+
+auto test_as_expected_value() {
+    auto value{ex::sync_wait(bt::as_expected(ex::just(17)))};
+    assert(value);
+    std::same_as<std::expected<int, std::monostate>> auto exp{std::get<0>(*value)};
+    assert(exp == 17);
+
+    auto none{ex::sync_wait(ex::just() | bt::as_expected)};
+    assert(none);
+    assert(std::get<0>(*none).has_value());
+
+    auto multi{ex::sync_wait(bt::as_expected(ex::just(17, std::string("hello"))))};
+    assert(multi);
+    assert(std::get<0>(*multi) == std::tuple(17, std::string("hello")));
+}
+
+auto test_as_expected_error() {
+    auto error{ex::sync_wait(bt::as_expected(ex::just_error(std::make_error_code(std::errc::io_error))))};
+    assert(error);
+    assert(not std::get<0>(*error));
+    assert(std::get<0>(*error).error() == std::errc::io_error);
+}
+
+auto test_as_expected_task() {
+    ex::sync_wait([]() -> ex::task<> {
+        std::expected<int, std::error_code> ok{co_await bt::as_expected(fail(false))};
+        assert(ok == 17);
+        std::expected<int, std::error_code> failed{co_await bt::as_expected(fail(true))};
+        assert(not failed);
+        assert(failed.error() == std::errc::io_error);
+    }());
+}
+} // namespace
+
+int main() {
+    test_into_optional();
+    test_as_expected_value();
+    test_as_expected_error();
+    test_as_expected_task();
+}
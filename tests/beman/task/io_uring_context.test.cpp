@@ -0,0 +1,154 @@
+// tests/beman/task/io_uring_context.test.cpp                         -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/io_uring_context.hpp>
+#include <beman/task/io_uring_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+#ifdef BEMAN_TASK_HAS_IO_URING
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+auto make_context(bt::io_uring_context::options opts = {}) -> std::optional<bt::io_uring_context> {
+    try {
+        return std::optional<bt::io_uring_context>(std::in_place, opts);
+    } catch (const std::system_error& error) {
+        // io_uring may be unavailable, e.g., disabled by a seccomp filter.
+        std::cout << "io_uring unavailable: " << error.what() << "\n";
+        return std::nullopt;
+    }
+}
+
+auto temp_path() -> std::string {
+    char name[]{"/tmp/beman-task-io_uring-XXXXXX"};
+    int  fd{::mkstemp(name)};
+    assert(0 <= fd);
+    ::close(fd);
+    return name;
+}
+
+auto test_file(bt::io_uring_context& context) {
+    auto path{temp_path()};
+    ex::sync_wait([](auto sched, std::string p) -> ex::task<> {
+        int fd{co_await bt::async_openat(sched, AT_FDCWD, p, O_RDWR | O_TRUNC)};
+        assert(0 <= fd);
+
+        std::string text{"hello, io_uring"};
+        auto        written{co_await bt::async_write(sched, fd, std::as_bytes(std::span(text)), 0u)};
+        assert(written == text.size());
+        co_await bt::async_fsync(sched, fd);
+
+        std::vector<std::byte> buffer(text.size());
+        auto                   read{co_await bt::async_read(sched, fd, std::span(buffer), 0u)};
+        assert(read == text.size());
+        assert(std::memcmp(buffer.data(), text.data(), text.size()) == 0);
+        ::close(fd);
+
+        try {
+            co_await bt::async_openat(sched, AT_FDCWD, p + "/does-not-exist", O_RDONLY);
+            assert(false);
+        } catch (const std::system_error& error) {
+            assert(error.code().value() == ENOTDIR);
+        }
+    }(context.get_scheduler(), path));
+    ::unlink(path.c_str());
+}
+
+auto test_registered(bt::io_uring_context& context) {
+    auto path{temp_path()};
+    int  fd{::open(path.c_str(), O_RDWR)};
+    assert(0 <= fd);
+    std::vector<std::byte> storage(4096u);
+    ::iovec                iov{storage.data(), storage.size()};
+    context.register_buffers(std::span(&iov, 1u));
+    context.register_files(std::span(&fd, 1u));
+
+    std::memcpy(storage.data(), "registered", 10u);
+    auto [written]{*ex::sync_wait(bt::async_write(context.get_scheduler(),
+                                                  bt::registered_file{0u},
+                                                  bt::registered_buffer{0u, std::span(storage).first(10u)},
+                                                  0u))};
+    assert(written == 10u);
+    std::memset(storage.data(), 0, storage.size());
+    auto [read]{*ex::sync_wait(bt::async_read(
+        context.get_scheduler(), bt::registered_file{0u}, bt::registered_buffer{0u, std::span(storage)}, 0u))};
+    assert(read == 10u);
+    assert(std::memcmp(storage.data(), "registered", 10u) == 0);
+    ::close(fd);
+    ::unlink(path.c_str());
+}
+
+auto test_cancel(bt::io_uring_context& context) {
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    ex::inplace_stop_source source;
+    std::byte               byte{};
+    std::thread             stopper([&source] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        source.request_stop();
+    });
+    // the read never completes on its own: nothing is written to the pipe
+    auto rc{ex::sync_wait(
+        ex::detail::write_env(bt::async_read(context.get_scheduler(), fds[0], std::span(&byte, 1u), ~0ull),
+                              ex::detail::make_env(ex::get_stop_token, source.get_token())))};
+    assert(not rc);
+    stopper.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+auto test_batch(bt::io_uring_context& context) {
+    // many tasks submitting concurrently are all completed
+    std::vector<std::thread> threads;
+    for (int t{}; t != 8; ++t) {
+        threads.emplace_back([&context] {
+            for (int i{}; i != 100; ++i) {
+                ex::sync_wait(ex::schedule(context.get_scheduler()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+} // namespace
+
+int main() {
+    if (auto context{make_context()}) {
+        test_file(*context);
+        test_registered(*context);
+        test_cancel(*context);
+        test_batch(*context);
+    }
+    if (auto context{make_context({.entries = 8u, .sqpoll = true})}) {
+        test_file(*context);
+        test_batch(*context);
+    }
+}
+#else
+int main() { std::cout << "io_uring isn't available on this platform\n"; }
+#endif
@@ -0,0 +1,80 @@
+// tests/beman/task/no_exceptions.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/exceptions.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <concepts>
+#include <system_error>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+// This test is built with exceptions disabled, e.g., using -fno-exceptions.
+
+#ifdef BEMAN_TASK_HAS_EXCEPTIONS
+#error "this test is meant to be built without exceptions"
+#endif
+
+namespace {
+struct error_context {
+    using error_types = ex::completion_signatures<ex::set_error_t(std::error_code)>;
+};
+
+auto leaf(bool fail) -> ex::task<int, error_context> {
+    if (fail) {
+        co_yield bt::with_error(std::make_error_code(std::errc::io_error));
+    }
+    co_return 17;
+}
+
+auto parent(bool fail, bool& resumed) -> ex::task<int, error_context> {
+    int value{co_await leaf(fail)};
+    resumed = true;
+    co_return value;
+}
+
+auto run(bool fail, bool& resumed) -> int {
+    auto result{ex::sync_wait(parent(fail, resumed) | ex::upon_error([](std::error_code) { return -1; }))};
+    assert(result);
+    return std::get<0>(*result);
+}
+
+auto test_errors() {
+    bool resumed{};
+    assert(run(false, resumed) == 17);
+    assert(resumed);
+    resumed = false;
+    // without exceptions errors of awaited tasks are forwarded
+    assert(run(true, resumed) == -1);
+    assert(not resumed);
+}
+
+auto test_default_task() {
+    auto result{ex::sync_wait([]() -> ex::task<int> { co_return co_await leaf(false); }())};
+    assert(result);
+    assert(std::get<0>(*result) == 17);
+}
+
+auto handler() noexcept -> void {}
+} // namespace
+
+int main() {
+    static_assert(std::same_as<bt::detail::error_types_of_t<bt::detail::default_environment>,
+                               ex::completion_signatures<>>);
+    static_assert(std::same_as<decltype(ex::schedule(std::declval<bt::task_scheduler&>()))::completion_signatures,
+                               ex::completion_signatures<ex::set_value_t(),
+                                                         ex::set_error_t(std::error_code),
+                                                         ex::set_stopped_t()>>);
+    assert(bt::set_failure_handler(&handler) == nullptr);
+    assert(bt::set_failure_handler(nullptr) == &handler);
+
+    test_errors();
+    test_default_task();
+}
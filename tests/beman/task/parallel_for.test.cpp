@@ -0,0 +1,148 @@
+// tests/beman/task/parallel_for.test.cpp                             -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/parallel_for.hpp>
+#include <beman/task/detail/single_thread_context.hpp>
+#include <beman/task/parallel_for.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+int schedules{0};
+int bulk_submissions{0};
+
+// An inline scheduler counting its submissions and, if Bulk is true,
+// supporting schedule_bulk natively.
+template <bool Bulk>
+struct counting_scheduler {
+    using scheduler_concept = ex::scheduler_t;
+
+    struct env {
+        auto query(const ex::get_completion_scheduler_t<ex::set_value_t>&) const noexcept -> counting_scheduler {
+            return {};
+        }
+    };
+    template <typename Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        Receiver receiver;
+        auto     start() & noexcept -> void { ex::set_value(std::move(this->receiver)); }
+    };
+    struct sender {
+        using sender_concept        = ex::sender_t;
+        using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const -> state<std::remove_cvref_t<Receiver>> {
+            return {std::forward<Receiver>(receiver)};
+        }
+        auto get_env() const noexcept -> env { return {}; }
+    };
+
+    auto schedule() const noexcept -> sender {
+        ++schedules;
+        return {};
+    }
+    template <typename Fn>
+        requires Bulk
+    auto schedule_bulk(std::size_t count, Fn&& fn) const {
+        ++bulk_submissions;
+        return bt::schedule_bulk(bt::inline_scheduler(), count, std::forward<Fn>(fn));
+    }
+    auto operator==(const counting_scheduler&) const -> bool = default;
+};
+
+template <typename Scheduler>
+auto submissions(Scheduler sched) {
+    schedules        = 0;
+    bulk_submissions = 0;
+    std::vector<int> values(100, 1);
+    ex::sync_wait(bt::parallel_for(sched, values, 10, [](int& v) { v *= 2; }));
+    assert(std::accumulate(values.begin(), values.end(), 0) == 200);
+}
+
+auto test_bulk_submission() {
+    // native bulk support: all chunks are submitted at once
+    submissions(counting_scheduler<true>());
+    assert(bulk_submissions == 1 && schedules == 0);
+    submissions(bt::task_scheduler(counting_scheduler<true>()));
+    assert(bulk_submissions == 1 && schedules == 0);
+
+    // otherwise each chunk is scheduled
+    submissions(counting_scheduler<false>());
+    assert(bulk_submissions == 0 && schedules == 10);
+    assert(not bt::task_scheduler(counting_scheduler<false>()).has_native_schedule_bulk());
+    submissions(bt::task_scheduler(counting_scheduler<false>()));
+    assert(bulk_submissions == 0 && schedules == 10);
+}
+auto test_parallel_for() {
+    std::vector<int> values(1000);
+    ex::sync_wait(bt::parallel_for(bt::inline_scheduler(), values, 64, [](int& v) { v = 1; }));
+    assert(std::accumulate(values.begin(), values.end(), 0) == 1000);
+
+    std::vector<int> empty;
+    assert(ex::sync_wait(bt::parallel_for(bt::inline_scheduler(), empty, 64, [](int&) { assert(false); })));
+}
+
+auto test_transform_reduce() {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    auto [sum]{*ex::sync_wait(bt::parallel_transform_reduce(
+        bt::inline_scheduler(), values, 100, 0L, std::plus<>(), [](int v) { return long(2 * v); }))};
+    assert(sum == 999L * 1000L);
+
+    std::vector<int> empty;
+    auto [init]{*ex::sync_wait(
+        bt::parallel_transform_reduce(bt::inline_scheduler(), empty, 100, 17, std::plus<>(), std::negate<>()))};
+    assert(init == 17);
+}
+
+auto test_error() {
+    std::vector<int> values(1000);
+    int              calls{0};
+    try {
+        ex::sync_wait(bt::parallel_for(bt::inline_scheduler(), values, 10, [&calls](int&) {
+            ++calls;
+            throw std::runtime_error("failure");
+        }));
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    // the remaining chunks are skipped once a chunk failed
+    assert(calls == 1);
+}
+
+auto test_task() {
+    ::beman::task::detail::single_thread_context context;
+    std::vector<int>                              values(100, 1);
+    auto                                          rc{ex::sync_wait([](auto sched, auto& v) -> ex::task<int> {
+        co_await bt::parallel_for(sched, v, 7, [](int& x) { x *= 3; });
+        co_return co_await bt::parallel_transform_reduce(sched, v, 7, 0, std::plus<>(), std::identity());
+    }(context.get_scheduler(), values))};
+    assert(rc);
+    [[maybe_unused]] auto [sum] = *rc;
+    assert(sum == 300);
+}
+} // namespace
+
+int main() {
+    test_parallel_for();
+    test_transform_reduce();
+    test_error();
+    test_bulk_submission();
+    test_task();
+}
@@ -0,0 +1,194 @@
+// tests/beman/task/priority_scheduler.test.cpp                       -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/priority_scheduler.hpp>
+#include <beman/task/priority_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <latch>
+#include <mutex>
+#include <utility>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct recorder {
+    std::mutex               mutex;
+    std::vector<std::size_t> order;
+    void                     add(std::size_t id) {
+        std::lock_guard guard(this->mutex);
+        this->order.push_back(id);
+    }
+};
+
+struct priority_env {
+    std::size_t priority;
+    auto        query(const bt::get_priority_t&) const noexcept { return this->priority; }
+};
+
+struct no_env {};
+
+template <typename Env = no_env>
+struct record_receiver {
+    using receiver_concept = ex::receiver_t;
+    recorder*   rec;
+    std::size_t id;
+    std::latch* done;
+    Env         env{};
+
+    void set_value() && noexcept {
+        this->rec->add(this->id);
+        this->done->count_down();
+    }
+    void set_error(auto&&) && noexcept { assert(false); }
+    void set_stopped() && noexcept { assert(false); }
+    auto get_env() const noexcept { return this->env; }
+};
+
+auto test_lanes(std::chrono::steady_clock::duration aging, const std::vector<std::size_t>& expected) {
+    bt::priority_context context(1u, 3u, aging);
+    recorder             rec;
+    std::promise<void>   started;
+    std::promise<void>   release;
+    std::latch           done{5};
+
+    // keep the only worker busy until all work is queued
+    auto blocker{ex::connect(ex::schedule(context.get_scheduler(0)) | ex::then([&] {
+                                 started.set_value();
+                                 release.get_future().wait();
+                             }),
+                             record_receiver<>{&rec, 99u, &done})};
+    ex::start(blocker);
+    started.get_future().wait();
+
+    auto op0{ex::connect(ex::schedule(context.get_scheduler(2)), record_receiver<>{&rec, 0u, &done})};
+    auto op1{ex::connect(ex::schedule(context.get_scheduler(1)), record_receiver<>{&rec, 1u, &done})};
+    auto op2{ex::connect(ex::schedule(context.get_scheduler(0)), record_receiver<>{&rec, 2u, &done})};
+    // the priority from the environment overrides the scheduler's lane
+    auto op3{ex::connect(ex::schedule(context.get_scheduler(2)),
+                         record_receiver<priority_env>{&rec, 3u, &done, priority_env{1u}})};
+    ex::start(op0);
+    ex::start(op1);
+    ex::start(op2);
+    ex::start(op3);
+    release.set_value();
+    done.wait();
+
+    assert(rec.order.size() == 5u);
+    assert(rec.order[0] == 99u);
+    assert(std::vector<std::size_t>(rec.order.begin() + 1, rec.order.end()) == expected);
+}
+
+struct lane_context {
+    auto query(const bt::get_priority_t&) const noexcept -> std::size_t { return 1u; }
+};
+
+// A sender completing when fire() is called, i.e., on the calling thread.
+struct trigger {
+    struct base {
+        virtual void fire() noexcept = 0;
+
+      protected:
+        ~base() = default;
+    };
+    base*              waiting{};
+    std::promise<void> armed;
+
+    struct sender {
+        using sender_concept        = ex::sender_t;
+        using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+        trigger* t;
+
+        template <ex::receiver Receiver>
+        struct state : base {
+            using operation_state_concept = ex::operation_state_t;
+            std::remove_cvref_t<Receiver> receiver;
+            trigger*                      t;
+            state(Receiver&& r, trigger* t) : receiver(std::forward<Receiver>(r)), t(t) {}
+            void                          start() & noexcept {
+                this->t->waiting = this;
+                this->t->armed.set_value();
+            }
+            void fire() noexcept override { ex::set_value(std::move(this->receiver)); }
+        };
+        template <ex::receiver Receiver>
+        auto connect(Receiver&& receiver) && {
+            return state<Receiver>(std::forward<Receiver>(receiver), this->t);
+        }
+    };
+    auto wait() { return sender{this}; }
+    void fire() { std::exchange(this->waiting, nullptr)->fire(); }
+};
+
+struct urgent_context {
+    auto query(const bt::get_priority_t&) const noexcept -> std::size_t { return 0u; }
+};
+
+auto test_continuation_lane() {
+    bt::priority_context context(1u, 3u, std::chrono::hours(1));
+    recorder             rec;
+    trigger              trig;
+    std::promise<void>   started;
+    std::promise<void>   release;
+    std::latch           done{3};
+
+    // The task runs on lane 2 via a task_scheduler but asks for lane 0.
+    auto task{ex::connect(ex::starts_on(context.get_scheduler(2),
+                                        [](trigger& t, recorder& r) -> ex::task<void, urgent_context> {
+                                            co_await t.wait();
+                                            r.add(7u);
+                                        }(trig, rec)),
+                          record_receiver<>{&rec, 8u, &done})};
+    ex::start(task);
+    trig.armed.get_future().wait();
+
+    auto blocker{ex::connect(ex::schedule(context.get_scheduler(0)) | ex::then([&] {
+                                 started.set_value();
+                                 release.get_future().wait();
+                             }),
+                             record_receiver<>{&rec, 99u, &done})};
+    ex::start(blocker);
+    started.get_future().wait();
+    auto marker{ex::connect(ex::schedule(context.get_scheduler(1)), record_receiver<>{&rec, 1u, &done})};
+    ex::start(marker);
+    // the continuation is scheduled from this thread while the worker is busy
+    trig.fire();
+    release.set_value();
+    done.wait();
+
+    // the continuation ran on lane 0, i.e., before the lane 1 marker
+    auto position{[&rec](std::size_t id) { return std::ranges::find(rec.order, id) - rec.order.begin(); }};
+    assert(position(7u) < position(1u));
+}
+
+auto test_task() {
+    bt::priority_context context(2u);
+    auto [priority]{*ex::sync_wait(
+        ex::starts_on(context.get_scheduler(2), []() -> ex::task<std::size_t, lane_context> {
+            co_await ex::just();
+            co_return co_await ex::read_env(bt::get_priority);
+        }()))};
+    assert(priority == 1u);
+}
+} // namespace
+
+int main() {
+    // lanes are served in priority order, FIFO within a lane
+    test_lanes(std::chrono::hours(1), {2u, 1u, 3u, 0u});
+    // with immediate aging the work is served in FIFO order
+    test_lanes(std::chrono::steady_clock::duration::zero(), {0u, 1u, 2u, 3u});
+    test_task();
+    test_continuation_lane();
+}
@@ -0,0 +1,116 @@
+// tests/beman/task/report_error_codes_of.test.cpp                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/report_error_codes_of.hpp>
+#include <beman/task/detail/error_types_of.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <concepts>
+#include <exception>
+#include <system_error>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct default_context {};
+struct error_code_context {
+    using scheduler_type = bt::inline_scheduler;
+    static constexpr bool report_error_codes{true};
+};
+
+// A scheduler whose schedule operation always fails with a std::errc.
+struct failing_scheduler {
+    using scheduler_concept = ex::scheduler_t;
+
+    struct env {
+        auto query(const ex::get_completion_scheduler_t<ex::set_value_t>&) const noexcept -> failing_scheduler {
+            return {};
+        }
+    };
+    template <typename Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        Receiver receiver;
+        auto     start() & noexcept -> void {
+            ex::set_error(std::move(this->receiver), std::errc::resource_unavailable_try_again);
+        }
+    };
+    struct sender {
+        using sender_concept = ex::sender_t;
+        using completion_signatures =
+            ex::completion_signatures<ex::set_value_t(), ex::set_error_t(std::errc), ex::set_stopped_t()>;
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const -> state<std::remove_cvref_t<Receiver>> {
+            return {std::forward<Receiver>(receiver)};
+        }
+        auto get_env() const noexcept -> env { return {}; }
+    };
+
+    auto schedule() const noexcept -> sender { return {}; }
+    auto operator==(const failing_scheduler&) const -> bool = default;
+};
+
+template <typename Task>
+auto error_of(Task&& task) -> std::error_code {
+    std::error_code result{};
+    ex::sync_wait(std::forward<Task>(task) | ex::upon_error([&result](auto error) {
+                      if constexpr (std::same_as<decltype(error), std::error_code>) {
+                          result = error;
+                      }
+                  }));
+    return result;
+}
+
+auto test_sender_error() {
+    bool resumed{};
+    auto ec{error_of([](bool& r) -> ex::task<void, error_code_context> {
+        co_await ex::just_error(std::errc::connection_reset);
+        r = true;
+    }(resumed))};
+    assert(ec == std::make_error_code(std::errc::connection_reset));
+    assert(not resumed);
+}
+
+auto child() -> ex::task<int, error_code_context> {
+    co_yield bt::with_error(std::make_error_code(std::errc::resource_unavailable_try_again));
+    co_return 0;
+}
+
+auto test_task_error() {
+    bool thrown{};
+    auto ec{error_of([](bool& t) -> ex::task<void, error_code_context> {
+        try {
+            co_await child();
+        } catch (...) {
+            t = true;
+        }
+    }(thrown))};
+    assert(ec == std::errc::resource_unavailable_try_again);
+    assert(not thrown);
+}
+
+auto test_scheduler_error() {
+    auto ec{error_of(ex::schedule(bt::task_scheduler(failing_scheduler{})))};
+    assert(ec == std::errc::resource_unavailable_try_again);
+}
+} // namespace
+
+int main() {
+    static_assert(not bt::detail::report_error_codes_of_v<default_context>);
+    static_assert(bt::detail::report_error_codes_of_v<error_code_context>);
+    static_assert(std::same_as<bt::detail::error_types_of_t<error_code_context>,
+                               ex::completion_signatures<ex::set_error_t(std::error_code),
+                                                         ex::set_error_t(std::exception_ptr)>>);
+
+    test_sender_error();
+    test_task_error();
+    test_scheduler_error();
+}
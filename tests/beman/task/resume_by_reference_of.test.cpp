@@ -0,0 +1,95 @@
+// tests/beman/task/resume_by_reference_of.test.cpp                   -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/resume_by_reference_of.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <concepts>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct value_context {
+    using scheduler_type = bt::inline_scheduler;
+};
+struct reference_context {
+    using scheduler_type = bt::inline_scheduler;
+    static constexpr bool resume_by_reference{true};
+};
+
+struct counted {
+    static inline int moves{};
+    int               value{};
+
+    explicit counted(int v) : value(v) {}
+    counted(counted&& other) noexcept : value(other.value) { ++moves; }
+};
+
+template <typename Context>
+auto produce(int value) -> ex::task<counted, Context> {
+    co_return counted(value);
+}
+
+auto consume(const counted& c) -> int { return c.value; }
+
+template <typename Context>
+auto moves_to_consume() -> int {
+    int result{};
+    ex::sync_wait([](int& r) -> ex::task<void, value_context> {
+        counted::moves = 0;
+        assert(consume(co_await produce<Context>(17)) == 17);
+        r = counted::moves;
+    }(result));
+    return result;
+}
+
+auto test_reference() {
+    ex::sync_wait([]() -> ex::task<void, value_context> {
+        static_assert(std::same_as<decltype(co_await produce<reference_context>(0)), counted&&>);
+        static_assert(std::same_as<decltype(co_await produce<value_context>(0)), counted>);
+        counted c{co_await produce<reference_context>(17)};
+        assert(c.value == 17);
+        counted d = co_await produce<reference_context>(42);
+        assert(d.value == 42);
+        co_return;
+    }());
+}
+
+auto test_auto() {
+    ex::sync_wait([]() -> ex::task<void, value_context> {
+        // the variable holds its own value which outlives the awaiter ...
+        auto x = co_await produce<reference_context>(17);
+        static_assert(std::same_as<decltype(x), counted>);
+        auto y = co_await produce<reference_context>(42);
+        assert(x.value == 17);
+        assert(y.value == 42);
+
+        // ... moved once out of the result object like a value produced without the opt-in
+        counted::moves = 0;
+        auto by_reference = co_await produce<reference_context>(1);
+        const int reference_moves{counted::moves};
+        counted::moves = 0;
+        auto by_value = co_await produce<value_context>(2);
+        assert(reference_moves == counted::moves);
+        assert(by_reference.value == 1 && by_value.value == 2);
+    }());
+}
+} // namespace
+
+int main() {
+    static_assert(not bt::detail::resume_by_reference_of_v<value_context>);
+    static_assert(bt::detail::resume_by_reference_of_v<reference_context>);
+
+    // the value isn't moved out of the awaiter
+    assert(moves_to_consume<reference_context>() < moves_to_consume<value_context>());
+    test_reference();
+    test_auto();
+}
@@ -0,0 +1,87 @@
+// tests/beman/task/schedule_bulk.test.cpp                            -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/schedule_bulk.hpp>
+#include <beman/task/priority_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+constexpr std::size_t count{1000u};
+
+struct counter {
+    std::vector<std::atomic<int>> hits = std::vector<std::atomic<int>>(count);
+
+    auto operator()(std::size_t i) noexcept { ++this->hits[i]; }
+    auto each_once() const -> bool {
+        for (const auto& hit : this->hits) {
+            if (hit != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template <typename Scheduler>
+auto test_bulk(Scheduler sched) {
+    counter c;
+    ex::sync_wait(bt::schedule_bulk(sched, count, [&c](std::size_t i) { c(i); }));
+    assert(c.each_once());
+
+    // an empty range completes right away
+    ex::sync_wait(bt::schedule_bulk(sched, 0u, [](std::size_t) { assert(false); }));
+}
+
+template <typename Scheduler>
+auto test_type_erased(Scheduler sched) {
+    counter c;
+    ex::sync_wait(bt::task_scheduler(sched).schedule_bulk(count, [&c](std::size_t i) { c(i); }));
+    assert(c.each_once());
+
+    try {
+        ex::sync_wait(bt::task_scheduler(sched).schedule_bulk(count, [](std::size_t i) {
+            if (i == 17u) {
+                throw std::runtime_error("bulk");
+            }
+        }));
+        assert(false);
+    } catch (const std::runtime_error&) {
+    }
+}
+
+auto test_task(bt::priority_scheduler sched) {
+    counter c;
+    ex::sync_wait(ex::starts_on(sched, [](counter& cnt) -> ex::task<> {
+        // the task's scheduler is a task_scheduler wrapping the priority scheduler
+        auto s{co_await ex::read_env(ex::get_scheduler)};
+        co_await s.schedule_bulk(count, [&cnt](std::size_t i) { cnt(i); });
+    }(c)));
+    assert(c.each_once());
+}
+} // namespace
+
+int main() {
+    bt::priority_context context(4u);
+    // native bulk submission
+    test_bulk(context.get_scheduler());
+    test_type_erased(context.get_scheduler());
+    test_task(context.get_scheduler());
+    // fallback using a single schedule()
+    test_bulk(bt::inline_scheduler());
+    test_type_erased(bt::inline_scheduler());
+}
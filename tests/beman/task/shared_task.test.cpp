@@ -0,0 +1,116 @@
+// tests/beman/task/shared_task.test.cpp                              -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/shared_task.hpp>
+#include <beman/task/shared_task.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+auto test_run_once() {
+    int  count{0};
+    auto shared{[](int& c) -> bt::shared_task<int> { co_return ++c; }(count)};
+    static_assert(ex::sender<decltype(shared)>);
+    static_assert(std::is_copy_constructible_v<decltype(shared)>);
+    assert(count == 0);
+
+    auto copy{shared};
+    auto r0{ex::sync_wait(shared)};
+    assert(r0);
+    assert(std::get<0>(*r0) == 1);
+    auto r1{ex::sync_wait(copy)};
+    assert(r1);
+    assert(std::get<0>(*r1) == 1);
+    assert(count == 1);
+}
+
+auto test_shared_reference() {
+    int  count{0};
+    auto shared{[](int& c) -> bt::shared_task<int> { co_return ++c; }(count)};
+    ex::sync_wait([](auto s0, auto s1) -> ex::task<> {
+        const int& v0{co_await s0};
+        const int& v1{co_await s1};
+        assert(v0 == 1);
+        assert(&v0 == &v1);
+    }(shared, shared));
+    assert(count == 1);
+}
+
+auto test_void() {
+    int  count{0};
+    auto shared{[](int& c) -> bt::shared_task<> {
+        ++c;
+        co_return;
+    }(count)};
+    ex::sync_wait([](auto s) -> ex::task<> {
+        co_await s;
+        co_await s;
+    }(shared));
+    assert(ex::sync_wait(shared));
+    assert(count == 1);
+}
+
+auto test_error() {
+    auto shared{[]() -> bt::shared_task<int> {
+        throw std::runtime_error("failure");
+        co_return 0;
+    }()};
+    for (int i{0}; i != 2; ++i) {
+        try {
+            ex::sync_wait(shared);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+}
+
+auto test_concurrent_subscribers() {
+    constexpr int subscribers{8};
+    for (int round{0}; round != 100; ++round) {
+        std::atomic<int>  count{0};
+        std::atomic<bool> go{false};
+        auto              shared{[](std::atomic<int>& c) -> bt::shared_task<int> { co_return ++c; }(count)};
+        std::atomic<int>  values{0};
+
+        std::vector<std::thread> threads;
+        for (int i{0}; i != subscribers; ++i) {
+            threads.emplace_back([&go, &values, copy = shared] {
+                while (not go.load()) {
+                }
+                auto result{ex::sync_wait(copy)};
+                assert(result);
+                values += std::get<0>(*result);
+            });
+        }
+        go = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        // exactly one subscriber started the coroutine and all got its value
+        assert(count == 1);
+        assert(values == subscribers);
+    }
+}
+} // namespace
+
+int main() {
+    test_run_once();
+    test_shared_reference();
+    test_void();
+    test_error();
+    test_concurrent_subscribers();
+}
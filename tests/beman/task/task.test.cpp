@@ -4,6 +4,9 @@
 #include <beman/task/task.hpp>
 #include <beman/execution/execution.hpp>
 #include <cassert>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
 
 namespace ex = beman::execution;
 
@@ -50,6 +53,60 @@ auto test_affinity() {
         }();
     }());
 }
+
+constexpr struct get_value_t {
+    template <typename Env>
+        requires requires(const get_value_t& self, const Env& e) { e.query(self); }
+    auto operator()(const Env& e) const -> int {
+        return e.query(*this);
+    }
+    constexpr auto query(const ex::forwarding_query_t&) const noexcept -> bool { return true; }
+} get_value{};
+
+// A context constructed from the upstream environment.
+struct value_context {
+    int value{};
+    auto query(const get_value_t&) const noexcept -> int { return this->value; }
+    explicit value_context(const auto& env)
+        requires(not std::same_as<value_context, std::remove_cvref_t<decltype(env)>>)
+        : value(get_value(env)) {}
+};
+
+// A context constructed from an own environment built from the upstream environment.
+struct own_env_context {
+    template <typename Env>
+    struct env_type {
+        int value;
+        explicit env_type(const Env& env) : value(get_value(env) + 1) {}
+    };
+    int value{};
+    auto query(const get_value_t&) const noexcept -> int { return this->value; }
+    template <typename Env>
+    explicit own_env_context(const env_type<Env>& own) : value(own.value) {}
+};
+
+template <typename Context>
+auto read_value() -> ex::task<int, Context> {
+    co_return co_await ex::read_env(get_value);
+}
+
+auto test_context_from_environment() {
+    // a connected task's context is constructed from the receiver's environment ...
+    auto value{ex::sync_wait(ex::detail::write_env(read_value<value_context>(), ex::detail::make_env(get_value, 17)))};
+    assert(value && std::get<0>(*value) == 17);
+    auto own{ex::sync_wait(ex::detail::write_env(read_value<own_env_context>(), ex::detail::make_env(get_value, 17)))};
+    assert(own && std::get<0>(*own) == 18);
+
+    // ... and an awaited task's context the same way from the awaiting coroutine's environment
+    ex::sync_wait(ex::detail::write_env(
+        []() -> ex::task<void, value_context> {
+            [[maybe_unused]] int value{co_await read_value<value_context>()};
+            assert(value == 17);
+            [[maybe_unused]] int own{co_await read_value<own_env_context>()};
+            assert(own == 18);
+        }(),
+        ex::detail::make_env(get_value, 17)));
+}
 } // namespace
 
 auto main() -> int {
@@ -57,4 +114,5 @@ auto main() -> int {
     test_cancel();
     test_indirect_cancel();
     test_affinity();
+    test_context_from_environment();
 }
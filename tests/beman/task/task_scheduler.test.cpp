@@ -5,13 +5,16 @@
 #include <beman/task/detail/inline_scheduler.hpp>
 #include <beman/execution/execution.hpp>
 #include <beman/execution/stop_token.hpp>
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <latch>
 #include <exception>
 #include <system_error>
 #include <thread>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 #ifdef NDEBUG
 #undef NDEBUG
 #endif
@@ -195,6 +198,48 @@ template <typename Token>
 stop_receiver(Token&&, stop_result&, std::latch* = nullptr) -> stop_receiver<std::remove_cvref_t<Token>>;
 static_assert(ex::receiver<stop_receiver<ex::inplace_stop_token>>);
 
+// Scheduler completing inline whose operation state doesn't fit into task_scheduler's buffer.
+struct big_scheduler {
+    using scheduler_concept = ex::scheduler_t;
+
+    template <ex::receiver Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        std::remove_cvref_t<Receiver> receiver;
+        std::array<std::byte, 1024u>  payload{};
+        void                          start() & noexcept { ex::set_value(std::move(this->receiver)); }
+    };
+    struct env {
+        big_scheduler query(const ex::get_completion_scheduler_t<ex::set_value_t>&) const noexcept { return {}; }
+    };
+    struct sender {
+        using sender_concept        = ex::sender_t;
+        using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+        template <ex::receiver Receiver>
+        auto connect(Receiver&& receiver) const -> state<Receiver> {
+            return {std::forward<Receiver>(receiver)};
+        }
+        env get_env() const noexcept { return {}; }
+    };
+
+    sender schedule() const noexcept { return {}; }
+    bool   operator==(const big_scheduler&) const = default;
+};
+static_assert(ex::scheduler<big_scheduler>);
+
+void test_big_state() {
+    ly::detail::task_scheduler sched{big_scheduler{}};
+    bool                       called{false};
+    ex::sync_wait(ex::schedule(sched) | ex::then([&called] { called = true; }));
+    assert(called);
+
+    // without a native schedule_bulk all calls are made sequentially on one agent
+    assert(not sched.has_native_schedule_bulk());
+    std::vector<std::size_t> indices;
+    ex::sync_wait(sched.schedule_bulk(4u, [&indices](std::size_t i) { indices.push_back(i); }));
+    assert((indices == std::vector<std::size_t>{0u, 1u, 2u, 3u}));
+}
+
 } // namespace
 
 // ----------------------------------------------------------------------------
@@ -319,6 +364,8 @@ int main() {
             completed.wait();
             assert(result == stop_result::success);
         }
+
+        test_big_state();
     } catch (...) {
         unexpected_call_assert("no exception should escape to main");
     }
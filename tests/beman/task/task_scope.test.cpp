@@ -0,0 +1,119 @@
+// tests/beman/task/task_scope.test.cpp                               -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/task_scope.hpp>
+#include <beman/task/detail/single_thread_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/task_scope.hpp>
+#include <beman/execution/execution.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct stats {
+    std::size_t allocations{};
+    std::size_t outstanding{};
+};
+
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+    stats* counts;
+
+    explicit counting_allocator(stats* s) : counts(s) {}
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) : counts(other.counts) {}
+
+    auto allocate(std::size_t n) -> T* {
+        ++this->counts->allocations;
+        this->counts->outstanding += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    auto deallocate(T* ptr, std::size_t n) -> void {
+        this->counts->outstanding -= n * sizeof(T);
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    auto operator==(const counting_allocator&) const -> bool = default;
+};
+
+auto test_spawn_tasks() {
+    beman::task::detail::single_thread_context context;
+    std::atomic<int>                           done{};
+    bt::task_scope<>                           scope;
+    for (int i{}; i != 100; ++i) {
+        scope.spawn(ex::detail::write_env([](std::atomic<int>& d) -> ex::task<> {
+                                              ++d;
+                                              co_return;
+                                          }(done),
+                                          ex::detail::make_env(ex::get_scheduler, context.get_scheduler())));
+    }
+    ex::sync_wait(scope.join());
+    assert(done == 100);
+}
+
+auto test_join_empty() {
+    bt::task_scope<> scope;
+    assert(ex::sync_wait(scope.join()));
+}
+
+auto test_pooled_storage() {
+    stats                                         counts;
+    bt::task_scope<counting_allocator<std::byte>> scope{counting_allocator<std::byte>(&counts)};
+    for (int round{}; round != 3; ++round) {
+        for (int i{}; i != 10; ++i) {
+            scope.spawn(ex::just());
+        }
+    }
+    // all jobs completed inline: the storage of the first job is reused
+    assert(counts.allocations == 1u);
+    for (int i{}; i != 17; ++i) {
+        scope.spawn(ex::read_env(ex::get_allocator) | ex::then([&counts](auto alloc) {
+                        assert(alloc == counting_allocator<std::byte>(&counts));
+                    }));
+    }
+    ex::sync_wait(scope.join());
+}
+
+auto test_stop() {
+    bt::task_scope<> scope;
+    bool             stopped{};
+    scope.request_stop();
+    assert(scope.get_stop_token().stop_requested());
+    scope.spawn(ex::read_env(ex::get_stop_token) | ex::then([&stopped](auto token) {
+                    stopped = token.stop_requested();
+                }));
+    ex::sync_wait(scope.join());
+    assert(stopped);
+}
+
+auto test_destroy_after_join() {
+    beman::task::detail::single_thread_context context;
+    for (int round{}; round != 1000; ++round) {
+        // the scope is destroyed as soon as the join completes while the
+        // last job may still be releasing it on the context's thread
+        auto scope{std::make_unique<bt::task_scope<>>()};
+        scope->spawn(ex::schedule(context.get_scheduler()));
+        ex::sync_wait(scope->join());
+        scope.reset();
+    }
+}
+} // namespace
+
+int main() {
+    test_spawn_tasks();
+    test_join_empty();
+    test_pooled_storage();
+    test_stop();
+    test_destroy_after_join();
+}
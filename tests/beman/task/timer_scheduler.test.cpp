@@ -0,0 +1,136 @@
+// tests/beman/task/timer_scheduler.test.cpp                          -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/timer_scheduler.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/timer_scheduler.hpp>
+#include <beman/execution/execution.hpp>
+#include <chrono>
+#include <cstddef>
+#include <latch>
+#include <mutex>
+#include <optional>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+using namespace std::chrono_literals;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct recorder {
+    std::mutex               mutex;
+    std::vector<std::size_t> fired;
+    std::vector<std::size_t> stopped;
+    void                     add(std::vector<std::size_t>& to, std::size_t id) {
+        std::lock_guard guard(this->mutex);
+        to.push_back(id);
+    }
+};
+
+struct stop_env {
+    ex::inplace_stop_token token;
+    auto                   query(const ex::get_stop_token_t&) const noexcept { return this->token; }
+};
+
+struct record_receiver {
+    using receiver_concept = ex::receiver_t;
+    recorder*              rec;
+    std::size_t            id;
+    std::latch*            done;
+    ex::inplace_stop_token token{};
+
+    void set_value() && noexcept {
+        this->rec->add(this->rec->fired, this->id);
+        this->done->count_down();
+    }
+    void set_stopped() && noexcept {
+        this->rec->add(this->rec->stopped, this->id);
+        this->done->count_down();
+    }
+    auto get_env() const noexcept { return stop_env{this->token}; }
+};
+
+auto test_order() {
+    bt::timer_context timers;
+    auto              sched{timers.get_scheduler()};
+    recorder          rec;
+    std::latch        done{4};
+    auto              start{clock_type::now()};
+
+    // the 150ms timer is placed on the second wheel and has to be cascaded
+    auto op0{ex::connect(bt::schedule_after(sched, 150ms), record_receiver{&rec, 0u, &done})};
+    auto op1{ex::connect(bt::schedule_after(sched, 20ms), record_receiver{&rec, 1u, &done})};
+    auto op2{ex::connect(bt::schedule_at(sched, start + 5ms), record_receiver{&rec, 2u, &done})};
+    auto op3{ex::connect(ex::schedule(sched), record_receiver{&rec, 3u, &done})};
+    ex::start(op0);
+    ex::start(op1);
+    ex::start(op2);
+    ex::start(op3);
+    done.wait();
+
+    assert(150ms <= clock_type::now() - start);
+    assert((rec.fired == std::vector<std::size_t>{3u, 2u, 1u, 0u}));
+    assert(rec.stopped.empty());
+}
+
+auto test_cancel() {
+    bt::timer_context       timers;
+    auto                    sched{timers.get_scheduler()};
+    recorder                rec;
+    std::latch              done{3};
+    ex::inplace_stop_source source0;
+    ex::inplace_stop_source source1;
+    ex::inplace_stop_source source2;
+    auto                    start{clock_type::now()};
+
+    auto op0{ex::connect(bt::schedule_after(sched, 1h), record_receiver{&rec, 0u, &done, source0.get_token()})};
+    auto op1{ex::connect(bt::schedule_after(sched, 1ms), record_receiver{&rec, 1u, &done, source1.get_token()})};
+    auto op2{ex::connect(bt::schedule_after(sched, 1h), record_receiver{&rec, 2u, &done, source2.get_token()})};
+    source2.request_stop();
+    ex::start(op0);
+    ex::start(op1);
+    ex::start(op2);
+    // cancellation removes the timer and completes it immediately
+    source0.request_stop();
+    assert((rec.stopped == std::vector<std::size_t>{2u, 0u}));
+    done.wait();
+
+    assert(clock_type::now() - start < 1h);
+    assert((rec.fired == std::vector<std::size_t>{1u}));
+}
+
+auto test_shutdown() {
+    recorder                         rec;
+    std::latch                       done{1};
+    std::optional<bt::timer_context> timers(std::in_place);
+    auto op{ex::connect(bt::schedule_after(timers->get_scheduler(), 1h), record_receiver{&rec, 0u, &done})};
+    ex::start(op);
+    // outstanding timers are stopped when the context is destroyed
+    timers.reset();
+    done.wait();
+    assert((rec.stopped == std::vector<std::size_t>{0u}));
+}
+
+auto test_task() {
+    bt::timer_context timers;
+    auto              sched{timers.get_scheduler()};
+    auto              start{clock_type::now()};
+    ex::sync_wait([](auto s) -> ex::task<> { co_await bt::schedule_after(s, 10ms); }(sched));
+    assert(10ms <= clock_type::now() - start);
+}
+} // namespace
+
+int main() {
+    test_order();
+    test_cancel();
+    test_shutdown();
+    test_task();
+}
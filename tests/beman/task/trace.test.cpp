@@ -0,0 +1,89 @@
+// tests/beman/task/trace.test.cpp                                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/logger.hpp>
+#include <beman/task/detail/trace.hpp>
+#include <beman/task/task.hpp>
+#include <cstddef>
+#include <string_view>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+struct event {
+    std::string_view name;
+    const void*      object;
+    int              level;
+    std::string_view scope;
+};
+
+event       events[8];
+std::size_t count{};
+
+void record(const char* name, const void* object) noexcept {
+    if (count < std::size(events)) {
+        // entry and exit events are reported with the logger as object
+        const bool       is_scope{name == bt::detail::logger::enter || name == bt::detail::logger::exit};
+        std::string_view scope{is_scope ? static_cast<const bt::detail::logger*>(object)->msg : ""};
+        events[count++] = event{name, object, bt::detail::logger::level(0), scope};
+    }
+}
+
+auto test_handler() {
+    int object{};
+    count = 0u;
+    bt::detail::trace("dropped", &object);
+    assert(count == 0u);
+
+    assert(bt::set_trace_handler(&record) == nullptr);
+    bt::detail::trace("traced", &object);
+    assert(count == 1u);
+    assert(events[0].name == "traced");
+    assert(events[0].object == &object);
+
+    assert(bt::set_trace_handler(nullptr) == &record);
+    bt::detail::trace("dropped", &object);
+    assert(count == 1u);
+}
+
+auto test_logger() {
+    count = 0u;
+    bt::set_trace_handler(&record);
+    const void* outer_address{};
+    const void* inner_address{};
+    {
+        bt::detail::logger outer("outer");
+        outer_address = &outer;
+        {
+            bt::detail::logger inner("inner");
+            inner_address = &inner;
+            inner.log("message");
+        }
+    }
+    bt::set_trace_handler(nullptr);
+
+    assert(count == 5u);
+    assert(events[0].name == "enter" && events[0].object == outer_address && events[0].level == 1);
+    assert(events[1].name == "enter" && events[1].object == inner_address && events[1].level == 2);
+    assert(events[2].name == "message" && events[2].object == inner_address && events[2].level == 2);
+    assert(events[3].name == "exit" && events[3].object == inner_address && events[3].level == 2);
+    assert(events[4].name == "exit" && events[4].object == outer_address && events[4].level == 1);
+    // entry and exit are distinct events of the same scope
+    assert(events[0].name != events[4].name);
+    assert(events[0].scope == "outer" && events[4].scope == "outer");
+    assert(events[1].scope == "inner" && events[3].scope == "inner");
+    assert(events[2].scope.empty());
+    assert(bt::detail::logger::level(0) == 0);
+}
+} // namespace
+
+int main() {
+    test_handler();
+    test_logger();
+}
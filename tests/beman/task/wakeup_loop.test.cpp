@@ -0,0 +1,42 @@
+// tests/beman/task/wakeup_loop.test.cpp                              -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/wakeup_loop.hpp>
+#include <beman/execution/execution.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+
+// ----------------------------------------------------------------------------
+
+#ifdef BEMAN_TASK_HAS_EVENTFD
+int main() {
+    beman::task::detail::wakeup_loop loop;
+    std::thread                      runner([&loop] { loop.run(); });
+    auto                             loop_id{runner.get_id()};
+
+    std::vector<std::thread> threads;
+    for (int t{}; t != 8; ++t) {
+        threads.emplace_back([&loop, loop_id] {
+            for (int i{}; i != 100; ++i) {
+                auto [id]{*ex::sync_wait(ex::schedule(loop.get_scheduler()) |
+                                         ex::then([] { return std::this_thread::get_id(); }))};
+                assert(id == loop_id);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    loop.finish();
+    runner.join();
+}
+#else
+int main() { std::cout << "eventfd isn't available on this platform\n"; }
+#endif
@@ -0,0 +1,116 @@
+// tests/beman/task/when_any.test.cpp                                 -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/when_any.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/when_any.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+// A sender which only completes once stop is requested.
+struct until_stopped {
+    using sender_concept        = ex::sender_t;
+    using completion_signatures = ex::completion_signatures<ex::set_value_t(int), ex::set_stopped_t()>;
+
+    bool* stopped;
+
+    template <ex::receiver Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        struct stopper {
+            state* st;
+            void   operator()() noexcept {
+                state* self{this->st};
+                self->callback.reset();
+                *self->stopped = true;
+                ex::set_stopped(std::move(self->receiver));
+            }
+        };
+        using token_t    = decltype(ex::get_stop_token(ex::get_env(std::declval<Receiver>())));
+        using callback_t = ex::stop_callback_for_t<token_t, stopper>;
+
+        std::remove_cvref_t<Receiver> receiver;
+        bool*                         stopped;
+        std::optional<callback_t>     callback;
+
+        template <typename R>
+        state(R&& r, bool* s) : receiver(std::forward<R>(r)), stopped(s) {}
+        void start() & noexcept {
+            auto token{ex::get_stop_token(ex::get_env(this->receiver))};
+            if (token.stop_requested()) {
+                *this->stopped = true;
+                ex::set_stopped(std::move(this->receiver));
+                return;
+            }
+            this->callback.emplace(token, stopper{this});
+        }
+    };
+
+    template <ex::receiver Receiver>
+    auto connect(Receiver&& receiver) && {
+        return state<Receiver>(std::forward<Receiver>(receiver), this->stopped);
+    }
+};
+static_assert(ex::sender<until_stopped>);
+
+auto test_first_value() {
+    auto rc{ex::sync_wait(bt::when_any(ex::just(17), ex::just(42)))};
+    assert(rc);
+    [[maybe_unused]] auto [value] = *rc;
+    assert(value == 17);
+}
+
+auto test_loser_is_stopped() {
+    bool stopped{false};
+    auto rc{ex::sync_wait(bt::when_any(until_stopped{&stopped}, ex::just(42)))};
+    assert(rc);
+    [[maybe_unused]] auto [value] = *rc;
+    assert(value == 42);
+    assert(stopped);
+}
+
+auto test_value_preferred() {
+    auto rc{ex::sync_wait(bt::when_any(ex::just_stopped() | ex::then([] { return 0; }), ex::just(42)))};
+    assert(rc);
+    [[maybe_unused]] auto [value] = *rc;
+    assert(value == 42);
+}
+
+auto test_all_stopped() {
+    auto rc{ex::sync_wait(bt::when_any(ex::just_stopped() | ex::then([] { return 0; }),
+                                       ex::just_stopped() | ex::then([] { return 1; })))};
+    assert(not rc);
+}
+
+auto test_tasks() {
+    ex::sync_wait([]() -> ex::task<> {
+        bool stopped{false};
+        auto value{co_await bt::when_any(
+            []() -> ex::task<int> { co_return 17; }(),
+            [](bool* s) -> ex::task<int> { co_return co_await until_stopped{s}; }(&stopped))};
+        assert(value == 17);
+        assert(stopped);
+    }());
+}
+} // namespace
+
+int main() {
+    test_first_value();
+    test_loser_is_stopped();
+    test_value_preferred();
+    test_all_stopped();
+    test_tasks();
+}
@@ -0,0 +1,147 @@
+// tests/beman/task/with_timeout.test.cpp                             -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/with_timeout.hpp>
+#include <beman/task/task.hpp>
+#include <beman/task/timer_scheduler.hpp>
+#include <beman/task/with_timeout.hpp>
+#include <beman/execution/execution.hpp>
+#include <beman/execution/stop_token.hpp>
+#include <chrono>
+#include <concepts>
+#include <exception>
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+using namespace std::chrono_literals;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+// A sender which only completes once stop is requested.
+struct until_stopped {
+    using sender_concept        = ex::sender_t;
+    using completion_signatures = ex::completion_signatures<ex::set_value_t(int), ex::set_stopped_t()>;
+
+    template <ex::receiver Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        struct stopper {
+            state* st;
+            void   operator()() noexcept {
+                state* self{this->st};
+                self->callback.reset();
+                ex::set_stopped(std::move(self->receiver));
+            }
+        };
+        using token_t    = decltype(ex::get_stop_token(ex::get_env(std::declval<Receiver>())));
+        using callback_t = ex::stop_callback_for_t<token_t, stopper>;
+
+        std::remove_cvref_t<Receiver> receiver;
+        std::optional<callback_t>     callback;
+
+        template <typename R>
+        explicit state(R&& r) : receiver(std::forward<R>(r)) {}
+        void start() & noexcept {
+            auto token{ex::get_stop_token(ex::get_env(this->receiver))};
+            if (token.stop_requested()) {
+                ex::set_stopped(std::move(this->receiver));
+                return;
+            }
+            this->callback.emplace(token, stopper{this});
+        }
+    };
+
+    template <ex::receiver Receiver>
+    auto connect(Receiver&& receiver) && {
+        return state<Receiver>(std::forward<Receiver>(receiver));
+    }
+};
+static_assert(ex::sender<until_stopped>);
+
+// Map the error completions to distinct values.
+auto classify() {
+    return ex::upon_error([]<typename E>(E e) {
+        if constexpr (std::same_as<E, std::error_code>) {
+            return e == std::errc::timed_out ? -1 : -2;
+        } else {
+            return -3;
+        }
+    });
+}
+
+// Task context providing the timer scheduler of the awaiting environment.
+struct timer_environment {
+    bt::timer_scheduler timer;
+    template <typename Env>
+    explicit timer_environment(const Env& env) : timer(bt::get_timer_scheduler(env)) {}
+    auto query(const bt::get_timer_scheduler_t&) const noexcept -> bt::timer_scheduler { return this->timer; }
+};
+
+auto test_value(bt::timer_scheduler sched) {
+    auto start{std::chrono::steady_clock::now()};
+    auto [value]{*ex::sync_wait(bt::with_timeout(ex::just(17), 1h, sched) | classify())};
+    assert(value == 17);
+    assert(std::chrono::steady_clock::now() - start < 1h);
+}
+
+auto test_timeout(bt::timer_scheduler sched) {
+    auto start{std::chrono::steady_clock::now()};
+    auto [value]{*ex::sync_wait(bt::with_timeout(until_stopped{}, 10ms, sched) | classify())};
+    assert(value == -1);
+    assert(10ms <= std::chrono::steady_clock::now() - start);
+
+    // without a timer scheduler argument the environment's one is used
+    auto [other]{*ex::sync_wait(ex::detail::write_env(bt::with_timeout(until_stopped{}, 1ms) | classify(),
+                                                      ex::detail::make_env(bt::get_timer_scheduler, sched)))};
+    assert(other == -1);
+}
+
+auto test_stopped(bt::timer_scheduler sched) {
+    ex::inplace_stop_source source;
+    source.request_stop();
+    auto rc{ex::sync_wait(ex::detail::write_env(bt::with_timeout(until_stopped{}, 1h, sched) | classify(),
+                                                ex::detail::make_env(ex::get_stop_token, source.get_token())))};
+    assert(not rc);
+}
+
+auto test_task(bt::timer_scheduler sched) {
+    ex::sync_wait([](bt::timer_scheduler s) -> ex::task<> {
+        assert(17 == co_await bt::with_timeout(ex::just(17), 1h, s));
+        try {
+            co_await bt::with_timeout(until_stopped{}, 1ms, s);
+            assert(false);
+        } catch (const std::system_error& error) {
+            assert(error.code() == std::errc::timed_out);
+        }
+    }(sched));
+
+    // a task's context provides the timer scheduler to awaited senders
+    ex::sync_wait(ex::detail::write_env(
+        []() -> ex::task<void, timer_environment> {
+            try {
+                co_await bt::with_timeout(until_stopped{}, 1ms);
+                assert(false);
+            } catch (const std::system_error& error) {
+                assert(error.code() == std::errc::timed_out);
+            }
+        }(),
+        ex::detail::make_env(bt::get_timer_scheduler, sched)));
+}
+} // namespace
+
+int main() {
+    bt::timer_context timers;
+    test_value(timers.get_scheduler());
+    test_timeout(timers.get_scheduler());
+    test_stopped(timers.get_scheduler());
+    test_task(timers.get_scheduler());
+}
@@ -0,0 +1,173 @@
+// tests/beman/task/yield.test.cpp                                    -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/task/detail/yield.hpp>
+#include <beman/task/detail/single_thread_context.hpp>
+#include <beman/task/task.hpp>
+#include <beman/execution/execution.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+
+namespace ex = beman::execution;
+namespace bt = beman::task;
+
+// ----------------------------------------------------------------------------
+
+namespace {
+constexpr int iterations{1000};
+
+struct budget_context {
+    static constexpr std::size_t resumption_budget{8u};
+};
+
+struct inline_context {
+    using scheduler_type = bt::inline_scheduler;
+};
+
+using loop_scheduler = decltype(std::declval<::beman::task::detail::single_thread_context&>().get_scheduler());
+
+struct loop_context {
+    using scheduler_type = loop_scheduler;
+};
+
+struct loop_budget_context {
+    using scheduler_type = loop_scheduler;
+    static constexpr std::size_t resumption_budget{8u};
+};
+
+// Sender completing inline which reports completing on `sched`, i.e.,
+// awaiting it from a task running on `sched` skips the reschedule.
+template <typename Scheduler>
+struct completes_on {
+    using sender_concept        = ex::sender_t;
+    using completion_signatures = ex::completion_signatures<ex::set_value_t()>;
+
+    struct env {
+        Scheduler sched;
+        auto      query(const ex::get_completion_scheduler_t<ex::set_value_t>&) const noexcept -> Scheduler {
+            return this->sched;
+        }
+    };
+    template <ex::receiver Receiver>
+    struct state {
+        using operation_state_concept = ex::operation_state_t;
+        std::remove_cvref_t<Receiver> receiver;
+        auto                          start() & noexcept -> void { ex::set_value(std::move(this->receiver)); }
+    };
+
+    Scheduler sched;
+
+    template <ex::receiver Receiver>
+    auto connect(Receiver&& r) const -> state<Receiver> {
+        return {std::forward<Receiver>(r)};
+    }
+    auto get_env() const noexcept -> env { return {this->sched}; }
+};
+
+template <typename Context>
+auto nothing() -> ex::task<void, Context> {
+    co_return;
+}
+
+// A task which awaits only tasks completing synchronously.
+template <typename Context>
+auto hog(int& progress) -> ex::task<void, Context> {
+    for (int i{}; i != iterations; ++i) {
+        co_await nothing<Context>();
+        ++progress;
+    }
+}
+
+// A task which awaits only senders completing synchronously on its scheduler.
+template <typename Context>
+auto sender_hog(loop_scheduler sched, int& progress) -> ex::task<void, Context> {
+    for (int i{}; i != iterations; ++i) {
+        co_await completes_on<loop_scheduler>{sched};
+        ++progress;
+    }
+}
+
+// A task which explicitly yields after each step.
+auto polite(int& progress) -> ex::task<> {
+    for (int i{}; i != iterations; ++i) {
+        ++progress;
+        co_await bt::yield();
+    }
+}
+
+auto observe(const int& progress, int& seen) -> ex::task<> {
+    seen = progress;
+    co_return;
+}
+
+// `make_hog(sched)` creates the task competing with the short tasks on `sched`.
+// All tasks are queued from the context's thread, i.e., before any of them runs.
+template <typename MakeHog>
+auto race(MakeHog make_hog, int& progress) -> int {
+    ::beman::task::detail::single_thread_context context;
+    auto                                          sched{context.get_scheduler()};
+    int                                           seen[4]{-1, -1, -1, -1};
+    ex::sync_wait(ex::starts_on(sched,
+                                ex::when_all(ex::starts_on(sched, make_hog(sched)),
+                                             ex::starts_on(sched, observe(progress, seen[0])),
+                                             ex::starts_on(sched, observe(progress, seen[1])),
+                                             ex::starts_on(sched, observe(progress, seen[2])),
+                                             ex::starts_on(sched, observe(progress, seen[3])))));
+    assert(progress == iterations);
+    int latest{0};
+    for (int s : seen) {
+        assert(0 <= s);
+        latest = std::max(latest, s);
+    }
+    return latest;
+}
+
+auto test_no_budget() {
+    int progress{0};
+    // Without a budget the hog runs to completion before anything else.
+    auto make_hog{[&progress](auto) { return hog<::beman::task::detail::default_environment>(progress); }};
+    assert(race(make_hog, progress) == iterations);
+}
+
+auto test_budget() {
+    int progress{0};
+    // With a budget the short tasks get to run while the hog is working.
+    assert(race([&progress](auto) { return hog<budget_context>(progress); }, progress) < iterations);
+}
+
+auto test_skipped_reschedule() {
+    int progress{0};
+    // The reschedule is skipped: without a budget nothing else gets to run.
+    auto make_hog{[&progress](loop_scheduler sched) { return sender_hog<loop_context>(sched, progress); }};
+    assert(race(make_hog, progress) == iterations);
+
+    progress = 0;
+    // The skipped reschedules count against the budget.
+    auto make_budget_hog{
+        [&progress](loop_scheduler sched) { return sender_hog<loop_budget_context>(sched, progress); }};
+    assert(race(make_budget_hog, progress) < iterations);
+}
+
+auto test_yield() {
+    int progress{0};
+    assert(race([&progress](auto) { return polite(progress); }, progress) < iterations);
+
+    ex::sync_wait([]() -> ex::task<void, inline_context> { co_await bt::yield(); }());
+}
+} // namespace
+
+int main() {
+    // the count of inline resumptions is only stored if there is a budget
+    static_assert(sizeof(ex::task<void>::promise_type) < sizeof(ex::task<void, budget_context>::promise_type));
+
+    test_no_budget();
+    test_budget();
+    test_skipped_reschedule();
+    test_yield();
+}
@@ -0,0 +1,106 @@
+// tools/frame_sizes.cpp                                              -*-C++-*-
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Print a histogram of coroutine frame sizes recorded by an application
+// built with BEMAN_TASK_FRAME_SIZE_REGISTRY and run with the environment
+// variable BEMAN_TASK_FRAME_SIZES naming the output file:
+//
+//     frame_sizes [--granularity bytes] file...
+//
+// The input is read from stdin if no file is given. Each line has the
+// format written by frame_registry::dump():
+// size<TAB>count<TAB>file:line<TAB>function. The coroutine is identified
+// by the remainder of the line following the count.
+// The histogram counts the allocations per size class of `granularity`
+// bytes (default 64, the size classes used by task_scope).
+
+namespace {
+using frames_t = std::map<std::pair<std::string, std::size_t>, std::size_t>;
+
+auto read(std::istream& in, frames_t& frames) -> void {
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::size_t        size{};
+        std::size_t        count{};
+        std::string        coroutine;
+        if (fields >> size >> count && std::getline(fields >> std::ws, coroutine)) {
+            frames[{coroutine, size}] += count;
+        }
+    }
+}
+
+auto print(const frames_t& frames, std::size_t granularity) -> void {
+    std::map<std::size_t, std::size_t> classes;
+    std::size_t                        total{};
+    for (const auto& [key, count] : frames) {
+        classes[(key.second + granularity - 1u) / granularity * granularity] += count;
+        total += count;
+    }
+    std::size_t most{};
+    for (const auto& [limit, count] : classes) {
+        most = std::max(most, count);
+    }
+
+    std::cout << "frame sizes of " << total << " allocations in classes of " << granularity << " bytes:\n";
+    std::size_t cumulative{};
+    for (const auto& [limit, count] : classes) {
+        cumulative += count;
+        std::cout << "  <= " << std::setw(6) << limit << ": " << std::setw(10) << count << std::setw(6)
+                  << (100u * cumulative / total) << "% " << std::string(count * 50u / most, '#') << "\n";
+    }
+
+    std::vector<std::pair<std::size_t, const frames_t::value_type*>> sorted;
+    for (const auto& entry : frames) {
+        sorted.emplace_back(entry.second, &entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::cout << "\nframes by allocations:\n";
+    for (const auto& [count, entry] : sorted) {
+        std::cout << std::setw(12) << count << std::setw(8) << entry->first.second << "  " << entry->first.first
+                  << "\n";
+    }
+}
+} // namespace
+
+int main(int ac, char* av[]) {
+    std::size_t granularity{64u};
+    frames_t    frames;
+    bool        read_file{};
+    for (int i{1}; i < ac; ++i) {
+        std::string_view arg{av[i]};
+        if (arg == "--granularity" && i + 1 < ac) {
+            granularity = std::max<std::size_t>(1u, std::strtoul(av[++i], nullptr, 10));
+        } else {
+            std::ifstream in(av[i]);
+            if (not in) {
+                std::cerr << "frame_sizes: can't open '" << arg << "'\n";
+                return EXIT_FAILURE;
+            }
+            read(in, frames);
+            read_file = true;
+        }
+    }
+    if (not read_file) {
+        read(std::cin, frames);
+    }
+    if (frames.empty()) {
+        std::cerr << "frame_sizes: no frame sizes recorded\n";
+        return EXIT_FAILURE;
+    }
+    print(frames, granularity);
+}